@@ -54,6 +54,7 @@ typedef struct ThreadConfig {
     uint32_t queue_process_interval_ms;  ///< How often to check queue (0 = every loop)
     uint32_t max_process_time_ms;        ///< Max time to spend processing queue (0 = no limit)
     uint32_t msg_batch_size;             ///< Max messages to process per batch (0 = no limit)
+    MessageQueueMode queue_mode;         ///< SPSC only if a single thread ever pushes to the queue
 } ThreadConfig;
 
 // Declare the template
@@ -14,6 +14,7 @@
 #define COMM_BUFFER_SIZE 8192
 #define SOCKET_ERROR_BUFFER_SIZE 256
 #define DEFAULT_BLOCKING_TIMEOUT_SEC 10
+#define COMM_SEND_PARK_MS 100  // Longest wait for messages, so a shutdown is still noticed
 
 typedef struct CommContext {
     PlatformSocketHandle socket;
@@ -25,6 +26,7 @@ typedef struct CommContext {
     size_t max_message_size;
     uint32_t timeout_ms;
     char foreign_queue_label[MAX_THREAD_LABEL_LENGTH];    // Using existing constant from thread_registry.h
+    char send_queue_label[MAX_THREAD_LABEL_LENGTH];       // Queue of the send thread, woken when the connection closes
 } CommContext;
 
 typedef struct CommConfig {
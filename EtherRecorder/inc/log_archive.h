@@ -0,0 +1,61 @@
+/**
+ * @file log_archive.h
+ * @brief Block-framed, seekable compression of rotated log files.
+ *
+ * An archive holds a log file as a sequence of independently compressed
+ * blocks, each made of whole lines and tagged with the range of log times
+ * of those lines. A block index at the end of the file lets a reader
+ * decompress only the blocks that overlap a requested time range.
+ *
+ * Layout, all integers little-endian:
+ *   file header   "ERLZ", version, block size, reserved      (4 x uint32)
+ *   blocks        raw size, stored size (uint32 x 2),
+ *                 min time, max time (int64 x 2), then the stored bytes;
+ *                 stored size equal to raw size means stored uncompressed
+ *   block index   offset (uint64), min time, max time (int64 x 2) per block
+ *   trailer       index offset (uint64), block count (uint32), "ERLX"
+ *
+ * Log times are the "YYYY-MM-DD HH:MM:SS" of each line (with a T for the
+ * space in JSON lines) counted as seconds, with no time zone applied. Lines
+ * without a timestamp take the time of the line before them.
+ */
+#ifndef LOG_ARCHIVE_H
+#define LOG_ARCHIVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_ARCHIVE_EXTENSION ".erlz"   // Appended to the name of the file compressed
+#define LOG_ARCHIVE_BLOCK_SIZE 0x10000  // Raw bytes per block (64 KB)
+
+/**
+ * @brief Compresses a log file into an archive.
+ * @param source_path The log file to compress. It is left in place.
+ * @param archive_path The archive to create, replacing any existing file.
+ * @return true on success; on failure no archive is left behind.
+ */
+bool log_archive_compress(const char* source_path, const char* archive_path);
+
+/**
+ * @brief Writes the lines of an archive whose log time lies within a range.
+ *
+ * Only blocks whose time range overlaps [from, to] are read and decompressed.
+ *
+ * @param archive_path The archive to read.
+ * @param from Earliest log time to include, as from log_archive_parse_time.
+ * @param to Latest log time to include, as from log_archive_parse_time.
+ * @param out Stream receiving the matching lines.
+ * @return true on success, false if the archive is unreadable or corrupt.
+ */
+bool log_archive_read_range(const char* archive_path, int64_t from, int64_t to, FILE* out);
+
+/**
+ * @brief Converts "YYYY-MM-DD HH:MM:SS" or "YYYY-MM-DDTHH:MM:SS" text to a log time.
+ * @param text The text; anything after the seconds is ignored.
+ * @param seconds Receives the log time.
+ * @return true if the text starts with a valid date and time.
+ */
+bool log_archive_parse_time(const char* text, int64_t* seconds);
+
+#endif // LOG_ARCHIVE_H
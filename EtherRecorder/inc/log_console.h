@@ -0,0 +1,36 @@
+/**
+ * @file log_console.h
+ * @brief Console log sink, writing log lines to stderr on its own thread.
+ *
+ * While the LOG_CONSOLE thread runs, the logger copies each line bound for
+ * the screen into a bounded ring and carries on; the thread writes the lines
+ * to stderr in batches. A slow or paused terminal therefore only fills the
+ * ring, after which screen lines are dropped and counted, and file logging
+ * never waits on it. Before the thread starts and after it stops, lines are
+ * written to stderr directly.
+ */
+#ifndef LOG_CONSOLE_H
+#define LOG_CONSOLE_H
+
+#include "app_thread.h"
+#include "log_line_ring.h"
+
+#define LOG_CONSOLE_THREAD_LABEL "LOG_CONSOLE"
+#define LOG_CONSOLE_WRITE_SIZE 0x4000    // Bytes per write to stderr (16 KB)
+
+/**
+ * @brief Get the console log sink thread configuration.
+ */
+ThreadConfig* get_log_console_thread(void);
+
+/**
+ * @brief Routes screen output through a ring, or back to stderr directly.
+ *
+ * Implemented by the logger, which takes the logging mutex, so once this
+ * returns no line is being pushed to a ring that was detached.
+ *
+ * @param ring The ring screen lines go to, or NULL to write them directly.
+ */
+void logger_attach_console_ring(LogLineRing* ring);
+
+#endif // LOG_CONSOLE_H
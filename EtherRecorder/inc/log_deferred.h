@@ -0,0 +1,41 @@
+/**
+ * @file log_deferred.h
+ * @brief Deferred formatting of log messages.
+ *
+ * Instead of running vsnprintf on the calling thread, the caller captures
+ * the raw argument bytes for a printf-style format string and the logger
+ * thread renders the text later. Rendering produces exactly the same bytes
+ * that vsnprintf would have produced for the same buffer size.
+ */
+#ifndef LOG_DEFERRED_H
+#define LOG_DEFERRED_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Captures the arguments of a printf-style call into a byte buffer.
+ * @param format The format string. Must outlive the captured record (string literal).
+ * @param args The variable argument list matching the format. Consumed by this call.
+ * @param buffer Destination for the captured argument bytes.
+ * @param size Size of the destination buffer.
+ * @return Number of bytes captured, or -1 if the arguments do not fit or the
+ *         format uses a conversion that cannot be deferred (e.g. %n, %ls).
+ */
+int log_deferred_capture(const char* format, va_list args, uint8_t* buffer, size_t size);
+
+/**
+ * @brief Renders captured arguments as text using their format string.
+ * @param out Destination text buffer, always null-terminated when out_size > 0.
+ * @param out_size Size of the destination buffer.
+ * @param format The format string used at capture time.
+ * @param args The captured argument bytes.
+ * @param args_size Number of captured argument bytes.
+ * @return Number of characters that would have been written, as vsnprintf,
+ *         or -1 if the captured record is malformed.
+ */
+int log_deferred_render(char* out, size_t out_size, const char* format,
+                        const uint8_t* args, size_t args_size);
+
+#endif // LOG_DEFERRED_H
@@ -0,0 +1,112 @@
+/**
+ * @file log_flight_recorder.h
+ * @brief Crash-surviving record of the most recent log entries.
+ *
+ * Every entry that is logged is also copied, in binary form, into a fixed
+ * slot of a ring held in a shared memory mapping of a file, ideally on
+ * tmpfs (e.g. /dev/shm). Entries are recorded on the calling thread before
+ * they are queued, so they are there even if the logger never wrote them:
+ * the mapping outlives the process, and after a crash or SIGKILL the
+ * flight_decode tool turns the file back into log lines.
+ *
+ * Deferred entries are kept as their captured arguments plus the id of
+ * their format string, interned once into a table in the same file, so
+ * recording an entry never formats it.
+ *
+ * File layout: a FlightRecorderHeader, the label table, the format table,
+ * then the record slots, at the offsets the header gives. The file is only
+ * meaningful to a decoder built for the same platform.
+ */
+#ifndef LOG_FLIGHT_RECORDER_H
+#define LOG_FLIGHT_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform_atomic.h"
+
+#define FLIGHT_RECORDER_MAGIC "ERFLIGHT"
+#define FLIGHT_RECORDER_VERSION 2
+#define FLIGHT_RECORDER_MIN_SIZE 0x100000   // Smallest file (1 MB)
+#define FLIGHT_RECORDER_SLOT_SIZE 256       // Bytes per record slot
+#define FLIGHT_RECORDER_LABEL_COUNT 256     // Labels held, as MAX_LOG_LABELS
+#define FLIGHT_RECORDER_LABEL_SIZE 64       // As THREAD_LABEL_SIZE
+#define FLIGHT_RECORDER_FORMAT_COUNT 1024   // Distinct format strings that can be interned
+#define FLIGHT_RECORDER_FORMAT_SIZE 256     // Bytes per format table entry
+#define FLIGHT_RECORDER_TEXT 0xFFFF         // format_id of a record holding formatted text
+
+/**
+ * @brief Start of the file. Written once when the recorder is opened.
+ */
+typedef struct FlightRecorderHeader {
+    char magic[8];                  // FLIGHT_RECORDER_MAGIC, written last
+    uint32_t version;
+    uint32_t slot_size;
+    uint32_t slot_count;
+    uint32_t format_count;
+    uint64_t labels_offset;         // Byte offsets from the start of the file
+    uint64_t formats_offset;
+    uint64_t slots_offset;
+    uint64_t reference_counter;     // A PlatformHighResTimestamp_T counter...
+    int64_t reference_seconds;      // ...and the calendar time it stands for
+    int64_t reference_nanoseconds;
+    uint64_t counter_frequency;     // Counter ticks per second
+    PlatformAtomicUInt32 closed;    // Set when the logger shut down cleanly
+} FlightRecorderHeader;
+
+/**
+ * @brief An interned format string.
+ */
+typedef struct FlightRecorderFormat {
+    PlatformAtomicUInt64 key;       // Address of the format string in the process, 0 while free
+    PlatformAtomicUInt32 ready;     // Set once text is complete
+    char text[FLIGHT_RECORDER_FORMAT_SIZE - 12];
+} FlightRecorderFormat;
+
+/**
+ * @brief A recorded log entry, one per slot.
+ */
+typedef struct FlightRecorderRecord {
+    PlatformAtomicUInt64 sequence;  // LogEntry_T.index once written, 0 while being written
+    uint64_t index;
+    uint64_t timestamp;             // PlatformHighResTimestamp_T counter
+    uint16_t label_id;
+    uint16_t level;
+    uint16_t format_id;             // Into the format table, or FLIGHT_RECORDER_TEXT
+    uint16_t payload_size;          // Bytes of captured arguments or of text (no terminator)
+    uint8_t payload[FLIGHT_RECORDER_SLOT_SIZE - 32];
+} FlightRecorderRecord;
+
+struct LogEntry_T;
+
+/**
+ * @brief Opens the recorder, creating the file and mapping it.
+ *
+ * A file left by the previous run is first renamed with a .prev suffix, so
+ * a restart after a crash does not overwrite what the crash left behind.
+ *
+ * @param file_name Path of the file; tmpfs keeps recording free of disk I/O.
+ * @param size Bytes to map, at least FLIGHT_RECORDER_MIN_SIZE.
+ * @return false if the file could not be created or mapped.
+ */
+bool log_flight_recorder_open(const char* file_name, uint64_t size);
+
+/**
+ * @brief Records a log entry. Safe from any thread; does nothing unless the recorder is open.
+ */
+void log_flight_recorder_record(const struct LogEntry_T* entry);
+
+/**
+ * @brief Records the name of an interned thread label.
+ */
+void log_flight_recorder_label(uint16_t label_id, const char* label);
+
+/**
+ * @brief Marks the file as left by a clean shutdown.
+ *
+ * The mapping itself is kept until the process exits, so a thread that
+ * logs while the application shuts down never writes to unmapped memory.
+ */
+void log_flight_recorder_mark_closed(void);
+
+#endif // LOG_FLIGHT_RECORDER_H
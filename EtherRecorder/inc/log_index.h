@@ -0,0 +1,74 @@
+/**
+ * @file log_index.h
+ * @brief Sparse side index of a log file, for seeking by entry index or time.
+ *
+ * Next to each log file the logger keeps <log file>.idx, holding a point
+ * for the first line it writes to the file and then for every Nth line.
+ * Each point maps a LogEntry_T.index and log time to the offset of the
+ * line in the file, so a reader can start close to what it is after
+ * instead of at the top of a multi-GB file. Rotation renames the index
+ * with its log file.
+ *
+ * Layout, all integers little-endian:
+ *   file header   "ERIX", version, interval, reserved          (4 x uint32)
+ *   points        entry index (uint64), log time (int64), offset (uint64)
+ *
+ * Log times are as in log_archive.h: the "YYYY-MM-DD HH:MM:SS" of the line
+ * counted as seconds, with no time zone applied. Points are in index order;
+ * their times only nearly so, as entries are stamped before they are queued.
+ */
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_INDEX_EXTENSION ".idx"  // Appended to the name of the log file indexed
+
+/**
+ * @brief A line of a log file the index points at.
+ */
+typedef struct LogIndexPoint {
+    uint64_t index;     // LogEntry_T.index of the line
+    int64_t time;       // Log time of the line
+    uint64_t offset;    // Byte offset of the line in the log file
+} LogIndexPoint;
+
+/**
+ * @brief Builds the path of a log file's index.
+ */
+void log_index_path(char* path, size_t size, const char* log_file_name);
+
+/**
+ * @brief Opens a log file's index for writing points, writing the header if the index is new.
+ * @param log_file_name The log file indexed.
+ * @param truncate Discard any existing index, as when the log file itself is truncated.
+ * @param interval Lines of the log file per point, recorded in the header.
+ * @return The index stream, or NULL if it could not be opened.
+ */
+FILE* log_index_open(const char* log_file_name, bool truncate, uint32_t interval);
+
+/**
+ * @brief Appends a point to an index opened with log_index_open.
+ */
+bool log_index_write_point(FILE* index, const LogIndexPoint* point);
+
+/**
+ * @brief Finds where to start reading a log file for lines from an entry index and a time on.
+ *
+ * Gives the offset of the last point before both, so nothing wanted is
+ * skipped. Lines are stamped before they are queued, so their times are
+ * only nearly in file order; callers pass a from early enough to allow for
+ * that. Without a usable index the whole file has to be read, from 0.
+ *
+ * @param log_file_name The log file.
+ * @param first_index Lowest entry index wanted, 0 for any.
+ * @param from Earliest log time wanted, INT64_MIN for any.
+ * @param offset Receives the offset to start reading at.
+ * @return true if the index was used, false if there is none or it is unreadable.
+ */
+bool log_index_find_start(const char* log_file_name, uint64_t first_index, int64_t from, uint64_t* offset);
+
+#endif // LOG_INDEX_H
@@ -0,0 +1,81 @@
+/**
+ * @file log_line_ring.h
+ * @brief Bounded, lossy ring of formatted log lines between the logger and a sink thread.
+ *
+ * The logger copies each line into the ring and carries on; a sink thread
+ * takes the lines out and writes them wherever they go. There is one
+ * producer at a time (the logger holds the logging mutex while it pushes)
+ * and one consumer. When the ring is full, new lines are dropped and
+ * counted, so a slow sink never holds up the logger.
+ */
+#ifndef LOG_LINE_RING_H
+#define LOG_LINE_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform_atomic.h"
+
+#define LOG_LINE_RING_MIN_SIZE 0x10000   // Smallest ring (64 KB)
+
+/**
+ * @brief A ring of newline-terminated lines, each held after its 16-bit length.
+ */
+typedef struct LogLineRing {
+    uint8_t* data;                          // NULL until initialised
+    uint32_t size;                          // Power of two
+    PlatformAtomicUInt32 head;              // Bytes ever written, moved by the producer
+    PlatformAtomicUInt32 tail;              // Bytes ever consumed, moved by the consumer
+    PlatformAtomicUInt32 consumer_parked;   // Set while the consumer waits for lines
+    PlatformAtomicUInt64 dropped;           // Lines that found the ring full
+} LogLineRing;
+
+/**
+ * @brief Allocates a ring.
+ * @param ring The ring.
+ * @param requested_size Bytes wanted, rounded up to a power of two of at least LOG_LINE_RING_MIN_SIZE.
+ * @return false if the memory could not be allocated.
+ */
+bool log_line_ring_init(LogLineRing* ring, uint32_t requested_size);
+
+/**
+ * @brief Releases a ring's memory. The ring must no longer be in use.
+ */
+void log_line_ring_free(LogLineRing* ring);
+
+/**
+ * @brief Copies a line into the ring, waking the consumer if it is parked. Never blocks.
+ * @param ring The ring.
+ * @param line The line, including its newline.
+ * @param length Length of the line.
+ * @return false if the line was dropped because the ring is full.
+ */
+bool log_line_ring_push(LogLineRing* ring, const char* line, size_t length);
+
+/**
+ * @brief Copies as many whole lines as fit in a buffer, leaving them in the ring.
+ * @param ring The ring.
+ * @param buffer Destination for the lines.
+ * @param capacity Size of the buffer.
+ * @param next_tail Receives the tail that consumes the lines copied, for log_line_ring_consume().
+ * @return Bytes copied, 0 if the ring is empty. Lines longer than the capacity are skipped.
+ */
+size_t log_line_ring_peek(LogLineRing* ring, char* buffer, size_t capacity, uint32_t* next_tail);
+
+/**
+ * @brief Releases the lines returned by log_line_ring_peek() once they are written.
+ */
+void log_line_ring_consume(LogLineRing* ring, uint32_t next_tail);
+
+/**
+ * @brief Waits until the producer pushes a line, or for the timeout.
+ */
+void log_line_ring_wait(LogLineRing* ring, uint32_t timeout_ms);
+
+/**
+ * @brief Returns the number of lines dropped since the ring was initialised.
+ */
+uint64_t log_line_ring_dropped(const LogLineRing* ring);
+
+#endif // LOG_LINE_RING_H
@@ -0,0 +1,32 @@
+/**
+ * @file log_maintenance.h
+ * @brief Background housekeeping of rotated log files.
+ *
+ * The logger thread hands each rotated log file to the LOG_MAINTENANCE
+ * thread, which compresses rotations into seekable archives (see
+ * log_archive.h) and prunes old rotations beyond the configured retention
+ * count, so that no file system scans, compression or deletes happen on
+ * the logging path.
+ */
+#ifndef LOG_MAINTENANCE_H
+#define LOG_MAINTENANCE_H
+
+#include <stdbool.h>
+
+#include "app_thread.h"
+
+#define LOG_MAINTENANCE_THREAD_LABEL "LOG_MAINTENANCE"
+
+/**
+ * @brief Get the log maintenance thread configuration.
+ */
+ThreadConfig* get_log_maintenance_thread(void);
+
+/**
+ * @brief Queues housekeeping for a log file that has just been rotated.
+ * @param log_file_name Path of the live log file (not the rotated copy).
+ * @return true if the request was queued, false if the maintenance thread is not running.
+ */
+bool log_maintenance_request(const char* log_file_name);
+
+#endif // LOG_MAINTENANCE_H
@@ -0,0 +1,50 @@
+/**
+ * @file log_network.h
+ * @brief Network log sink, streaming log lines to a remote collector over UDP or TCP.
+ *
+ * The logger thread copies each line bound for the network into a bounded
+ * ring and carries on; the LOG_NETWORK thread owns the socket, connects and
+ * reconnects with backoff, and sends the lines coalesced into datagrams of
+ * at most LOG_NETWORK_DATAGRAM_SIZE bytes (UDP) or writes of at most
+ * LOG_NETWORK_WRITE_SIZE bytes (TCP). Each datagram or write holds whole
+ * lines, newline terminated as in the log files, so the stream needs no
+ * other framing and a plain listener such as "nc -klu 7020" shows the log.
+ * While the collector is unreachable lines wait in the ring; when it is
+ * full, new lines are dropped and counted.
+ */
+#ifndef LOG_NETWORK_H
+#define LOG_NETWORK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "app_thread.h"
+
+#define LOG_NETWORK_THREAD_LABEL "LOG_NETWORK"
+#define LOG_NETWORK_DATAGRAM_SIZE 1400   // UDP payload that fits a 1500 byte MTU with room for headers
+#define LOG_NETWORK_WRITE_SIZE 0x4000    // Bytes per TCP write (16 KB)
+
+/**
+ * @brief Sets up the sink from the [logger] log_host, log_port, log_protocol and log_network_buffer_size settings.
+ * @return true if lines can be sent to the network from now on.
+ */
+bool log_network_init(void);
+
+/**
+ * @brief Queues a formatted log line for the collector.
+ *
+ * Called with the logging mutex held, so there is a single producer at a time.
+ * Never blocks.
+ *
+ * @param line The line, including its newline.
+ * @param length Length of the line.
+ * @return false if the line was dropped because the ring is full.
+ */
+bool log_network_enqueue(const char* line, size_t length);
+
+/**
+ * @brief Get the network log sink thread configuration.
+ */
+ThreadConfig* get_log_network_thread(void);
+
+#endif // LOG_NETWORK_H
@@ -1,6 +1,23 @@
 /*
 * @file log_queue.h
 * @brief Contains the log queue functions.
+*
+* The log queue is a pool of single-producer/single-consumer rings. Each
+* thread that logs claims a ring of its own on its first push, so producers
+* never contend with each other. There is a consumer per logger worker, and
+* a thread claims a separate ring for each worker it logs to; each worker
+* pops only its own rings and merges them back into index order. Every log
+* file is written by one worker, so its entries stay in order.
+*
+* Rings are byte arenas of variable-length records: a LogRecordHeader_T
+* followed by only the message bytes actually used, padded to
+* LOG_RECORD_ALIGN. A record that would straddle the end of the arena is
+* placed at its start instead, the gap marked with a wrap record.
+*
+* When a ring has no room, the configured LogOverflowPolicy decides what
+* happens, without taking any lock. Every entry dropped is counted, and the
+* next entry the thread gets onto its ring carries the count so the logger
+* can report the gap in place.
 */
 #ifndef LOG_QUEUE_H
 #define LOG_QUEUE_H
@@ -10,23 +27,83 @@
 #include "platform_atomic.h"
 
 
-#define LOG_QUEUE_SIZE 0x8000  // Size of the log queue
+#define LOG_RING_COUNT 32        // Rings in the pool, i.e. threads that can log concurrently via the queue
+#define LOG_RING_BYTES 0x40000   // Bytes per ring (256 KB), must be a power of two
+#define LOG_RECORD_ALIGN 8       // Records start on this boundary within a ring
+#define LOG_CACHE_LINE_SIZE 64   // Keeps producer and consumer indices on separate cache lines
+#define LOG_OVERFLOW_BLOCK_TIMEOUT_MS 1000  // Longest a producer waits for room before dropping
+#define LOG_MAX_WORKERS 8        // Logger threads that can consume from the queue
 
-// Slot states - using uint8_t since we only need 2 bits
+// Ring ownership states
 typedef enum {
-    SLOT_EMPTY    = 0,  // Available for writing
-    SLOT_RESERVED = 1,  // Being written to
-    SLOT_WRITTEN  = 2   // Ready for reading
-} LogQueueSlotState;
+    LOG_RING_FREE    = 0,  // Available to be claimed by a thread
+    LOG_RING_ACTIVE  = 1,  // Owned by a producer thread
+    LOG_RING_RETIRED = 2   // Owner has exited, freed once the logger has drained it
+} LogRingState;
+
+// What a producer does when its ring has no room for an entry
+typedef enum {
+    LOG_OVERFLOW_BLOCK,             // Wait for the logger to make room, dropping after LOG_OVERFLOW_BLOCK_TIMEOUT_MS
+    LOG_OVERFLOW_DROP_NEWEST,       // Discard the entry being logged
+    LOG_OVERFLOW_DROP_OLDEST,       // Discard the thread's oldest queued entries to make room
+    LOG_OVERFLOW_DROP_BELOW_LEVEL,  // Discard entries below the overflow level, wait for the rest
+    LOG_OVERFLOW_SAMPLE             // From half full, keep one entry in every sample rate
+} LogOverflowPolicy;
+
+// Outcome of pushing an entry
+typedef enum {
+    LOG_PUSH_QUEUED,   // The entry is on the calling thread's ring
+    LOG_PUSH_DROPPED,  // The entry was discarded under the overflow policy, and counted
+    LOG_PUSH_NO_RING   // No ring was free; the caller should log the entry directly
+} LogPushResult;
+
+/**
+ * @brief Header of a record in a log ring. The message or captured arguments follow it.
+ */
+typedef struct LogRecordHeader_T {
+    uint32_t size;                          // Whole record including header and padding
+    uint16_t label_id;                      // Interned thread label, or LOG_RECORD_WRAP
+    uint16_t payload_size;                  // Message bytes (without terminator) or argument bytes
+    uint64_t index;
+    PlatformHighResTimestamp_T timestamp;
+    const char* format;                     // As LogEntry_T.format
+    uint16_t level;                         // LogLevel
+    uint16_t route;                         // As LogEntry_T.route
+    uint32_t dropped;                       // Entries the thread dropped just before this one
+} LogRecordHeader_T;
+
+#define LOG_RECORD_WRAP 0xFFFF  // label_id of a record marking the rest of the arena unused
+
+/**
+ * @brief A single-producer/single-consumer ring of log records.
+ *
+ * head and tail are free-running byte counts; their difference is the
+ * number of bytes in use.
+ */
+typedef struct LogRing_T {
+    PlatformAtomicUInt32 head;   // Bytes written, only advanced by the owning thread
+    uint8_t head_pad[LOG_CACHE_LINE_SIZE - sizeof(PlatformAtomicUInt32)];
+    PlatformAtomicUInt32 tail;   // Bytes consumed, advanced by its worker (and by drop_oldest)
+    uint8_t tail_pad[LOG_CACHE_LINE_SIZE - sizeof(PlatformAtomicUInt32)];
+    PlatformAtomicUInt32 state;  // Uses LogRingState values
+    PlatformAtomicUInt32 worker; // Worker that consumes the ring, set before its first record
+    PlatformAtomicUInt32 producer_parked;  // Non-zero while the owner is parked waiting for room
+    uint64_t data[LOG_RING_BYTES / sizeof(uint64_t)];  // Record arena, 8-byte aligned
+} LogRing_T;
 
 /**
  * @brief Structure representing a log queue.
  */
 typedef struct {
-    LogEntry_T entries[LOG_QUEUE_SIZE];
-    PlatformAtomicUInt32 head;
-    PlatformAtomicUInt32 tail;
-    PlatformAtomicUInt8 slot_states[LOG_QUEUE_SIZE];  // Uses LogQueueSlotState values
+    LogRing_T rings[LOG_RING_COUNT];
+    PlatformAtomicUInt32 ring_count;  // Number of rings ever claimed; the logger scans only these
+    PlatformAtomicUInt32 consumer_parked[LOG_MAX_WORKERS];  // Non-zero while a worker is parked waiting for entries
+    PlatformAtomicUInt32 worker_running[LOG_MAX_WORKERS];   // Set while a worker's own thread consumes its entries;
+                                                            // worker 0 stands in for workers not running
+    PlatformAtomicUInt64 dropped_total;    // Entries dropped by the overflow policy since start up
+    LogOverflowPolicy overflow_policy;
+    LogLevel overflow_level;               // Lowest level kept under LOG_OVERFLOW_DROP_BELOW_LEVEL
+    uint32_t sample_rate;                  // One in this many kept under LOG_OVERFLOW_SAMPLE
 } LogQueue_T;
 
 extern LogQueue_T global_log_queue; // Declare the log queue
@@ -37,15 +114,85 @@ extern LogQueue_T global_log_queue; // Declare the log queue
  */
 void log_queue_init(LogQueue_T *queue);
 
+/**
+ * @brief Sets what producers do when their ring is full. Call before logging starts.
+ * @param queue The log queue.
+ * @param policy The overflow policy.
+ * @param overflow_level Entries at or above this level are never dropped by LOG_OVERFLOW_DROP_BELOW_LEVEL.
+ * @param sample_rate One entry in this many is kept by LOG_OVERFLOW_SAMPLE under pressure.
+ */
+void log_queue_set_overflow_policy(LogQueue_T *queue, LogOverflowPolicy policy,
+                                   LogLevel overflow_level, uint32_t sample_rate);
 
-bool log_queue_push(LogQueue_T *log_queue, const LogEntry_T *entry);
+/**
+ * @brief Marks the calling thread as one of the queue's consumers.
+ *
+ * A consumer never waits for room on a ring, since it might be the one
+ * that has to make that room; policies that would wait drop the entry instead.
+ */
+void log_queue_set_consumer_thread(void);
+
+/**
+ * @brief Pushes a log entry onto the calling thread's ring for a worker.
+ * @param log_queue The log queue.
+ * @param entry The log entry to push.
+ * @param worker The worker that writes the entry's log file.
+ * @return The outcome; with LOG_PUSH_NO_RING the caller should log the entry directly.
+ */
+LogPushResult log_queue_push(LogQueue_T *log_queue, const LogEntry_T *entry, uint32_t worker);
 
 /**
- * @brief Pops a log entry from the log queue.
+ * @brief Pops the oldest log entry across a worker's rings. That worker only.
  * @param queue The log queue.
+ * @param worker The worker popping.
  * @param entry The log entry to populate.
- * @return 0 on success, -1 if the queue is empty.
+ * @return true if an entry was popped, false if all of the worker's rings are empty.
+ */
+bool log_queue_pop(LogQueue_T *queue, uint32_t worker, LogEntry_T *entry);
+
+/**
+ * @brief Marks whether a worker's own thread is consuming its entries.
+ *
+ * Worker 0 is taken as always running. While another worker is not, its
+ * entries wake worker 0 instead, which drains them on its behalf.
+ */
+void log_queue_set_worker_running(LogQueue_T *queue, uint32_t worker, bool running);
+
+/**
+ * @brief Tells whether a worker's own thread is consuming its entries.
+ */
+bool log_queue_worker_running(const LogQueue_T *queue, uint32_t worker);
+
+/**
+ * @brief Parks a worker until an entry is pushed for it or the timeout expires.
+ *
+ * Producers only make a system call to signal a worker that is parked, so
+ * the common push path stays free of them. Worker 0 also wakes for entries
+ * of the workers it stands in for.
+ *
+ * @param queue The log queue.
+ * @param worker The worker parking.
+ * @param timeout_ms Maximum time to park in milliseconds.
+ * @return true if entries are available, false if the worker's rings are still empty.
+ */
+bool log_queue_wait(LogQueue_T *queue, uint32_t worker, uint32_t timeout_ms);
+
+/**
+ * @brief Gets the number of entries dropped by the overflow policy since start up.
+ */
+uint64_t log_queue_dropped_count(const LogQueue_T *queue);
+
+/**
+ * @brief Gets the number of bytes currently queued across all rings.
+ */
+uint32_t log_queue_depth_bytes(const LogQueue_T *queue);
+
+/**
+ * @brief Releases the calling thread's rings back to the pool.
+ *
+ * Entries still in a ring are drained by its worker before the ring is
+ * reused. Call this as the last logging action of a thread.
  */
-bool log_queue_pop(LogQueue_T *queue, LogEntry_T *entry);
+void log_queue_release_thread_ring(void);
 
 #endif // LOG_QUEUE_H
@@ -16,6 +16,7 @@
 
 #define LOG_MSG_BUFFER_SIZE 1024 // Buffer size for log messages
 #define THREAD_LABEL_SIZE 64 // Buffer size for thread labels
+#define MAX_LOG_LABELS 256   // Distinct thread labels that can be interned
 
 #ifdef _DEBUG
 /*
@@ -41,23 +42,33 @@ typedef enum LogLevel {
 
 /**
  * @enum LogOutput
- * @brief Defines the possible output destinations for logs.
+ * @brief Defines the possible output destinations for logs, as flags that combine.
  */
 typedef enum LogOutput {
-    LOG_OUTPUT_SCREEN,  // Only screen (stderr or stdout)
-    LOG_OUTPUT_FILE,    // Only file/stderr
-    LOG_OUTPUT_BOTH     // Both screen/stderr and file
+    LOG_OUTPUT_SCREEN = 0x1,   // Screen (stderr or stdout)
+    LOG_OUTPUT_FILE = 0x2,     // Log files
+    LOG_OUTPUT_BOTH = 0x3,     // Both screen/stderr and file
+    LOG_OUTPUT_NETWORK = 0x4   // Remote collector, see log_network.h
 } LogOutput;
 
 /**
  * @brief Structure representing a log entry.
+ *
+ * When format is NULL, message holds the formatted text. Otherwise formatting
+ * was deferred: message holds args_size bytes of captured arguments and the
+ * logger thread renders the text from format when the entry is written.
+ * The thread label is held as an interned id, see logger_label_name().
  */
 typedef struct LogEntry_T {
     uint64_t index;
     LogLevel level;
     PlatformHighResTimestamp_T timestamp;
+    const char* format;     // Format string of a deferred entry, NULL if already formatted
+    uint16_t args_size;     // Bytes of captured arguments in message when deferred
+    uint16_t label_id;      // Interned thread label
+    uint16_t route;         // Log file the entry is written to, resolved from the label when the entry is created
+    uint32_t dropped;       // Entries the thread dropped on queue overflow just before this one
     char message[LOG_MSG_BUFFER_SIZE];
-    char thread_label[THREAD_LABEL_SIZE];
 } LogEntry_T;
 
 
@@ -78,6 +89,18 @@ void init_thread_timestamp_system(void);
  */
 void create_log_entry(LogEntry_T* entry, LogLevel level, const char* message);
 
+/**
+ * @brief Interns a thread label, returning a small id that stands for it in log entries.
+ * @param label The thread label. NULL is interned as "UNKNOWN".
+ * @return The label id. Labels beyond MAX_LOG_LABELS share the id of "UNKNOWN".
+ */
+uint16_t logger_intern_label(const char* label);
+
+/**
+ * @brief Gets the thread label for an interned label id.
+ */
+const char* logger_label_name(uint16_t label_id);
+
 /**
  * @brief Sets a thread-specific log file from configuration.
  */
@@ -113,9 +136,59 @@ const char* get_level_name(LogLevel level);
  */
 void logger_set_level(LogLevel level);
 
+/**
+ * @brief Sets the log level of the threads with a label, overriding the global level for them.
+ */
+void logger_set_label_level(const char* label, LogLevel level);
+
+/**
+ * @brief Checks whether the calling thread logs entries of a level.
+ *
+ * Used by the logger_log macro before any arguments are evaluated. The
+ * thread's effective level is cached per thread and only looked up again
+ * after a level has been changed.
+ */
+bool logger_level_enabled(LogLevel level);
+
+/**
+ * @brief Token bucket of one rate-limited log site, see logger_log_limited.
+ */
+typedef struct LogRateLimit {
+    uint32_t last_ticks;    // Tick count the credit was last topped up at
+    uint32_t credit_ms;     // One entry is allowed per log_rate_limit interval of credit
+    uint32_t suppressed;    // Entries held back since the last one allowed
+    bool started;
+    bool listed;            // On the thread's list of sites holding entries back
+    LogLevel level;         // Level, file and line of the site, for its suppression summary
+    const char* file;
+    int line;
+    struct LogRateLimit* next_listed;
+} LogRateLimit;
+
+/**
+ * @brief Takes a token from a log site's bucket.
+ *
+ * A site that holds entries back is listed for the calling thread, so its
+ * count is still reported if the site goes quiet: by the thread's next log
+ * call once the site has been quiet for a rate limit interval, or by
+ * logger_rate_limit_flush.
+ *
+ * @param site The site's bucket, private to the calling thread.
+ * @param repeats Receives the entries suppressed since the last one allowed, when allowed.
+ * @return true if the entry should be logged.
+ */
+bool logger_rate_limit_allow(LogRateLimit* site, LogLevel level, const char* file, int line, uint32_t* repeats);
+
+/**
+ * @brief Reports the entries every rate-limited site of the calling thread is holding back.
+ *        Called as a thread exits.
+ */
+void logger_rate_limit_flush(void);
+
 /**
  * @brief Internal logging function - use logger_log macro instead.
- * @note This function should not be called directly. Use the logger_log macro.
+ * @note This function should not be called directly. Use the logger_log macro,
+ *       which also does the level filtering.
  */
 void _logger_log(LogLevel level, const char* format, ...);
 
@@ -124,4 +197,16 @@ void _logger_log(LogLevel level, const char* format, ...);
  */
 ThreadConfig* get_logger_thread(void);
 
+/**
+ * @brief Gets the number of logger workers configured by log_worker_threads, including the LOGGER thread.
+ */
+uint32_t logger_worker_count(void);
+
+/**
+ * @brief Get the configuration of an additional logger worker thread.
+ * @param worker The worker, from 1 up to logger_worker_count(); worker 0 is the LOGGER thread.
+ * @return The thread configuration, or NULL if there is no such worker.
+ */
+ThreadConfig* get_logger_worker_thread(uint32_t worker);
+
 #endif // LOGGER_H
@@ -7,6 +7,22 @@
 
 #include "logger.h"
 
+/*
+ * Entries below LOG_COMPILE_MIN_LEVEL are compiled out: with a constant level the
+ * call and its arguments are removed as dead code. Build with, for example,
+ * -DLOG_COMPILE_MIN_LEVEL=LOG_INFO to drop TRACE and DEBUG entirely.
+ */
+#ifndef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL LOG_TRACE
+#endif
+
+/*
+ * Checked before the arguments are evaluated, against the level of the calling
+ * thread's label (e.g. client.log_level) or else the global log_level.
+ */
+#define LOGGER_LEVEL_ENABLED(level) \
+    ((level) >= LOG_COMPILE_MIN_LEVEL && logger_level_enabled(level))
+
 #ifdef _DEBUG
 /*
  * In debug builds, if the log level is LOG_TRACE (or if g_trace_all is true),
@@ -35,7 +51,8 @@
   #define logger_log(level, fmt, ...) \
       __pragma(warning(push)) \
       __pragma(warning(disable:4003)) \
-      ((level) == LOG_TRACE || g_trace_all ? \
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : \
+       (level) == LOG_TRACE || g_trace_all ? \
         _logger_log_with_file_line(level, fmt, ##__VA_ARGS__) : \
         _logger_log_without_file_line(level, fmt, ##__VA_ARGS__)) \
       __pragma(warning(pop))
@@ -44,14 +61,16 @@
   #pragma clang diagnostic push
   #pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
   #define logger_log(level, fmt, ...) \
-      ((level) == LOG_TRACE || g_trace_all ? \
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : \
+       (level) == LOG_TRACE || g_trace_all ? \
         _logger_log_with_file_line(level, fmt, ##__VA_ARGS__) : \
         _logger_log_without_file_line(level, fmt, ##__VA_ARGS__))
   #pragma clang diagnostic pop
 #else
   // GCC and others
   #define logger_log(level, fmt, ...) \
-      ((level) == LOG_TRACE || g_trace_all ? \
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : \
+       (level) == LOG_TRACE || g_trace_all ? \
         _logger_log_with_file_line(level, fmt, ##__VA_ARGS__) : \
         _logger_log_without_file_line(level, fmt, ##__VA_ARGS__))
 #endif
@@ -65,18 +84,41 @@
   #define logger_log(level, fmt, ...) \
       __pragma(warning(push)) \
       __pragma(warning(disable:4003)) \
-      _logger_log(level, fmt, ##__VA_ARGS__) \
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : _logger_log(level, fmt, ##__VA_ARGS__)) \
       __pragma(warning(pop))
 #elif defined(__clang__)
   #pragma clang diagnostic push
   #pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
   #define logger_log(level, fmt, ...) \
-      _logger_log(level, fmt, ##__VA_ARGS__)
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : _logger_log(level, fmt, ##__VA_ARGS__))
   #pragma clang diagnostic pop
 #else
   #define logger_log(level, fmt, ...) \
-      _logger_log(level, fmt, ##__VA_ARGS__)
+      (!LOGGER_LEVEL_ENABLED(level) ? (void)0 : _logger_log(level, fmt, ##__VA_ARGS__))
 #endif
 #endif
 
+/*
+ * logger_log for sites that can repeat without bound, such as timeouts and
+ * heartbeats. Each call site has a token bucket, per thread so no shared state
+ * is touched, allowing log_rate_limit_burst entries at once and then
+ * log_rate_limit_per_minute. Entries held back are reported as
+ * "N similar messages suppressed" before the next one let through, or once
+ * the site has gone quiet. Only the site is compared, not the text.
+ */
+#define logger_log_limited(level, fmt, ...) \
+    do { \
+        static THREAD_LOCAL LogRateLimit logger_site_limit_; \
+        uint32_t logger_site_repeats_; \
+        if (LOGGER_LEVEL_ENABLED(level) && \
+            logger_rate_limit_allow(&logger_site_limit_, level, __FILE__, __LINE__, \
+                                    &logger_site_repeats_)) { \
+            if (logger_site_repeats_) { \
+                _logger_log(level, "[%s:%d] %u similar messages suppressed", \
+                            __FILE__, __LINE__, logger_site_repeats_); \
+            } \
+            logger_log(level, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
 #endif // LOGGER_MACROS_H
@@ -0,0 +1,127 @@
+/**
+ * @file logger_metrics.h
+ * @brief Self-metrics of the logger: queue depth, push latency, drain rate,
+ *        bytes written, rotation time and drops.
+ *
+ * Producers and the logger thread record into lock-free counters and log2
+ * histograms; any thread can take a consistent-enough snapshot with
+ * logger_metrics_get(). The logger thread also writes a summary line every
+ * log_metrics_interval_s seconds when that is configured.
+ */
+#ifndef LOGGER_METRICS_H
+#define LOGGER_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform_atomic.h"
+
+#define LOGGER_HISTOGRAM_BUCKETS 40      // Bucket i holds values in [2^(i-1), 2^i), the last everything above
+#define LOGGER_METRICS_PUSH_SAMPLE 16    // Push latency is timed on one push in this many per thread
+#define LOGGER_METRICS_MAX_FILES 16      // Log files reported in a snapshot
+#define LOGGER_METRICS_NAME_SIZE 64      // Stored length of a log file name in a snapshot
+
+/**
+ * @brief A histogram of nanosecond values, updated with atomic operations only.
+ */
+typedef struct LoggerHistogram {
+    PlatformAtomicUInt64 buckets[LOGGER_HISTOGRAM_BUCKETS];
+    PlatformAtomicUInt64 count;
+    PlatformAtomicUInt64 sum;
+    PlatformAtomicUInt64 max;
+} LoggerHistogram;
+
+/**
+ * @brief A point-in-time copy of a histogram.
+ */
+typedef struct LoggerHistogramSnapshot {
+    uint64_t buckets[LOGGER_HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+} LoggerHistogramSnapshot;
+
+/**
+ * @brief Bytes written to one log file.
+ */
+typedef struct LogFileMetrics {
+    char file_name[LOGGER_METRICS_NAME_SIZE];  // Without its directory
+    uint64_t bytes_written;                    // Since start up, across rotations
+    uint32_t rotations;
+} LogFileMetrics;
+
+/**
+ * @brief A snapshot of all logger metrics.
+ */
+typedef struct LoggerMetrics {
+    uint64_t entries_written;         // Entries drained and written by the logger thread
+    uint64_t entries_dropped;         // Entries dropped by the queue overflow policy
+    uint64_t drain_batches;           // Batches drained by the logger thread
+    uint64_t drain_busy_ns;           // Time the logger thread spent draining
+    uint32_t queue_depth_bytes;       // Bytes queued across all rings at the time of the snapshot
+    uint32_t queue_depth_high_water;  // Most bytes seen queued in a single ring
+    uint32_t ring_bytes;              // Capacity of a single ring
+    LoggerHistogramSnapshot push_latency_ns;
+    LoggerHistogramSnapshot rotation_ns;
+    LogFileMetrics files[LOGGER_METRICS_MAX_FILES];
+    int file_count;
+} LoggerMetrics;
+
+/**
+ * @brief Adds a value to a histogram.
+ */
+void logger_histogram_record(LoggerHistogram* histogram, uint64_t value);
+
+/**
+ * @brief Estimates a percentile of a histogram snapshot.
+ * @param snapshot The snapshot.
+ * @param percentile Between 0 and 100.
+ * @return The upper bound of the bucket holding the percentile, capped at the maximum seen.
+ */
+uint64_t logger_histogram_percentile(const LoggerHistogramSnapshot* snapshot, double percentile);
+
+/**
+ * @brief Records the time taken by a push onto the log queue.
+ */
+void logger_metrics_record_push(uint64_t latency_ns);
+
+/**
+ * @brief Records the bytes queued in a producer's ring, keeping the high-water mark.
+ */
+void logger_metrics_record_depth(uint32_t ring_depth_bytes);
+
+/**
+ * @brief Records a batch drained by the logger thread.
+ */
+void logger_metrics_record_drain(uint32_t entries, uint64_t elapsed_ns);
+
+/**
+ * @brief Records how long a log file rotation took.
+ */
+void logger_metrics_record_rotation(uint64_t elapsed_ns);
+
+/**
+ * @brief Takes a snapshot of all logger metrics.
+ */
+void logger_metrics_get(LoggerMetrics* metrics);
+
+/**
+ * @brief Formats a one-line summary of the metrics.
+ * @param now The current snapshot.
+ * @param previous The snapshot the rates are measured from, or NULL for totals only.
+ * @param elapsed_ms Time between the two snapshots.
+ * @param buffer Destination for the text.
+ * @param size Size of the destination.
+ */
+void logger_metrics_format_summary(const LoggerMetrics* now, const LoggerMetrics* previous,
+                                   uint32_t elapsed_ms, char* buffer, size_t size);
+
+/**
+ * @brief Copies the per-file metrics. Implemented by the logger, which owns the file table.
+ * @param files Destination array.
+ * @param max_files Capacity of the array.
+ * @return The number of files copied.
+ */
+int logger_get_file_metrics(LogFileMetrics* files, int max_files);
+
+#endif // LOGGER_METRICS_H
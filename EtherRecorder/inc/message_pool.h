@@ -0,0 +1,60 @@
+/**
+ * @file message_pool.h
+ * @brief Reference-counted message buffers, allocated from size-classed slabs.
+ *
+ * Messages travel between threads by handle: message queues carry Message_T
+ * pointers, never copies. A producer allocates a message with room for the
+ * content it expects, fills the content in place, for instance straight from
+ * recv or a file read, and pushes it. Pushing hands the producer's reference
+ * to the queue and popping hands it to the consumer, which releases it once
+ * done. Anyone keeping a message beyond that takes a reference of their own
+ * with message_retain.
+ *
+ * Each size class has its own slabs of MESSAGE_POOL_SLAB_BYTES, added as
+ * needed up to MESSAGE_POOL_MAX_SLABS and reused through a lock-free free
+ * list; they are only returned to the system by message_pool_cleanup.
+ */
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "message_queue_types.h"
+
+#define MESSAGE_POOL_SLAB_BYTES 0x40000  // Bytes added to a size class at a time (256 KB)
+#define MESSAGE_POOL_MAX_SLABS 256       // Limits each size class to 64 MB
+
+/**
+ * @brief Prepares the pool. Call once, before any thread allocates a message.
+ */
+bool message_pool_init(void);
+
+/**
+ * @brief Frees every slab. Call once no thread holds or can allocate a message.
+ */
+void message_pool_cleanup(void);
+
+/**
+ * @brief Takes a buffer from the pool, holding one reference.
+ *
+ * The buffer comes from the smallest size class that fits, so
+ * header.capacity may be more than asked for.
+ *
+ * @param type Message type to set in the header; content_size starts at 0.
+ * @param capacity Content bytes needed, at most MESSAGE_MAX_CONTENT_SIZE.
+ * @return The message, or NULL if capacity is too large or the pool is exhausted.
+ */
+Message_T* message_alloc(MessageType type, size_t capacity);
+
+/**
+ * @brief Adds a reference to a message.
+ */
+void message_retain(Message_T* message);
+
+/**
+ * @brief Drops a reference to a message, returning it to the pool with the last one.
+ */
+void message_release(Message_T* message);
+
+#endif // MESSAGE_POOL_H
@@ -2,6 +2,7 @@
 #define MESSAGE_QUEUE_TYPES_H
 
 #include <stdint.h>
+#include "platform_atomic.h"
 #include "platform_sync.h"
 
 #ifdef _MSC_VER
@@ -10,6 +11,9 @@
 
 // Message content size matches typical MTU minus protocol headers
 #define MESSAGE_CONTENT_SIZE 1472  // 1500 (MTU) - 20 (IP) - 8 (UDP/Other headers)
+#define MESSAGE_MAX_CONTENT_SIZE 0x10000  // Largest content a message can be allocated with (64 KB)
+
+#define MESSAGE_QUEUE_CACHE_LINE_SIZE 64  // Keeps producer and consumer indices on separate cache lines
 
 // Message types
 typedef enum {
@@ -17,7 +21,8 @@ typedef enum {
     MSG_TYPE_TEST = 2,
     MSG_TYPE_FILE_CHUNK = 3,  // For file chunks
     MSG_TYPE_CONTROL = 4,
-    MSG_TYPE_DATA = 5
+    MSG_TYPE_DATA = 5,
+    MSG_TYPE_LOG_ROTATED = 6  // Content is the path of a log file that has just been rotated
 } MessageType;
 
 
@@ -38,26 +43,54 @@ typedef struct {
 typedef struct {
     MessageType type;         ///< Message type identifier
     size_t content_size;   ///< Size of content in bytes
+    size_t capacity;       ///< Bytes content can hold, fixed when the message is allocated
 } MessageHeader_T;
 
 /**
  * @brief Message structure for inter-thread communication
+ *
+ * Allocated with message_alloc for the content size needed, see message_pool.h.
  */
 typedef struct {
     MessageHeader_T header;  ///< Message header
-    uint8_t content[MESSAGE_CONTENT_SIZE];  ///< Message content buffer
+    uint8_t content[];       ///< Message content buffer, header.capacity bytes
 } Message_T;
 
+/**
+ * @brief Which threads may use a message queue, chosen per queue
+ *
+ * MPMC is the zero value, so a thread configured without a mode gets the
+ * queue that is safe whoever pushes to it.
+ */
+typedef enum {
+    MESSAGE_QUEUE_MPMC = 0,  ///< Any number of producer and consumer threads
+    MESSAGE_QUEUE_SPSC = 1   ///< Exactly one producer thread and one consumer thread
+} MessageQueueMode;
+
 /**
  * @brief Queue structure for message storage
+ *
+ * A lock-free bounded ring of message handles. head and tail are free-running positions;
+ * max_size is a power of two, so a position's slot is position & mask.
+ * An SPSC queue publishes a message by a release store of tail and frees
+ * its slot by a release store of head, each read with acquire by the other
+ * side. An MPMC queue claims positions by compare-exchange on head and tail,
+ * and each slot's sequence says whose turn it is: position for a producer,
+ * position + 1 for a consumer, position + max_size once consumed.
  */
 typedef struct {
-    Message_T* entries;               ///< Array of messages
-    volatile int32_t head;           ///< Index of head (atomic access)
-    volatile int32_t tail;           ///< Index of tail (atomic access)
-    int32_t max_size;                ///< Maximum number of messages allowed
+    PlatformAtomicUInt32 tail;       ///< Next position to write, advanced by producers
+    uint8_t tail_pad[MESSAGE_QUEUE_CACHE_LINE_SIZE - sizeof(PlatformAtomicUInt32)];
+    PlatformAtomicUInt32 head;       ///< Next position to read, advanced by consumers
+    uint8_t head_pad[MESSAGE_QUEUE_CACHE_LINE_SIZE - sizeof(PlatformAtomicUInt32)];
+    Message_T** entries;             ///< Handles of the queued messages, see message_pool.h
+    PlatformAtomicUInt32* sequences; ///< Turn of each slot, MPMC only (NULL for SPSC)
+    uint32_t max_size;               ///< Maximum number of messages allowed, a power of two
+    uint32_t mask;                   ///< max_size - 1
+    MessageQueueMode mode;           ///< Producer and consumer discipline
     PlatformEvent_T not_empty_event; ///< Event for signaling queue not empty
     PlatformEvent_T not_full_event;  ///< Event for signaling queue not full
+    PlatformAtomicUInt32 wakeups;    ///< Bumped by message_queue_wake to end blocked pops
     const char* owner_label;         ///< Label identifying the queue owner
 } MessageQueue_T;
 
@@ -8,8 +8,62 @@ extern "C" {
 #endif
 
 // Function declarations
-bool message_queue_push(MessageQueue_T* queue, const Message_T* message, uint32_t timeout_ms);
-bool message_queue_pop(MessageQueue_T* queue, Message_T* message, uint32_t timeout_ms);
+
+/**
+ * @brief Sets up an empty queue.
+ * @param queue The queue to set up.
+ * @param max_size Capacity in messages, a power of two.
+ * @param mode Whether the queue may have more than one producer or consumer thread.
+ * @param owner_label Label of the thread that owns the queue.
+ * @return false if max_size is not a power of two or allocation failed.
+ */
+bool message_queue_init(MessageQueue_T* queue, uint32_t max_size, MessageQueueMode mode, const char* owner_label);
+
+/**
+ * @brief Frees what message_queue_init allocated, releasing any messages still queued.
+ *
+ * Nothing may be using the queue.
+ */
+void message_queue_destroy(MessageQueue_T* queue);
+
+/**
+ * @brief Queues a message from message_alloc, handing the caller's reference to the queue.
+ * @return false if the queue stayed full for timeout_ms; the caller still owns the message.
+ */
+bool message_queue_push(MessageQueue_T* queue, Message_T* message, uint32_t timeout_ms);
+
+/**
+ * @brief Takes the oldest message, with the reference the queue held; release it when done.
+ * @return false if the queue stayed empty for timeout_ms.
+ */
+bool message_queue_pop(MessageQueue_T* queue, Message_T** message, uint32_t timeout_ms);
+
+/**
+ * @brief Queues several messages in order, waking the consumer once rather than per message.
+ *
+ * Pushes what fits straight away and waits up to timeout_ms for room for the rest.
+ *
+ * @return The number queued, from the start of messages; the caller still owns the others.
+ */
+uint32_t message_queue_push_batch(MessageQueue_T* queue, Message_T* const* messages, uint32_t count,
+                                  uint32_t timeout_ms);
+
+/**
+ * @brief Takes up to max_count of the oldest messages in one go, waking any waiting producer once.
+ *
+ * Waits up to timeout_ms for the first message, then takes whatever else is already queued.
+ *
+ * @return The number taken, 0 if the queue stayed empty or message_queue_wake cut the wait
+ *         short; each is the caller's to release.
+ */
+uint32_t message_queue_pop_batch(MessageQueue_T* queue, Message_T** messages, uint32_t max_count,
+                                 uint32_t timeout_ms);
+
+/**
+ * @brief Ends the wait of any thread blocked popping from the queue, so it can recheck
+ *        why it is waiting, for instance whether its connection has closed.
+ */
+void message_queue_wake(MessageQueue_T* queue);
 
 #ifdef __cplusplus
 }
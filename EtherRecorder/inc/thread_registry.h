@@ -54,8 +54,19 @@ bool thread_registry_is_registered(const ThreadConfig* thread);
 
 // Message queue operations
 ThreadRegistryError init_queue(const char* thread_label);
-ThreadRegistryError push_message(const char* thread_label, const Message_T* message, uint32_t timeout_ms);
-ThreadRegistryError pop_message(const char* thread_label, Message_T* message, uint32_t timeout_ms);
+// Queues carry message handles, see message_pool.h: push hands over the caller's reference on
+// success only, and a popped message is the caller's to release
+ThreadRegistryError push_message(const char* thread_label, Message_T* message, uint32_t timeout_ms);
+ThreadRegistryError pop_message(const char* thread_label, Message_T** message, uint32_t timeout_ms);
+// Batch forms: one lookup and one wakeup for up to count messages. push_messages reports
+// THREAD_REG_QUEUE_FULL if it could not queue them all; the caller still owns those after *pushed
+ThreadRegistryError push_messages(const char* thread_label, Message_T* const* messages, uint32_t count,
+                                  uint32_t timeout_ms, uint32_t* pushed);
+ThreadRegistryError pop_messages(const char* thread_label, Message_T** messages, uint32_t max_count,
+                                 uint32_t timeout_ms, uint32_t* popped);
+// Ends a blocked pop on the thread's queue, see message_queue_wake; the registry lock keeps
+// the queue from being freed by a thread deregistering meanwhile
+ThreadRegistryError wake_queue(const char* thread_label);
 
 // Helper function for queue access
 MessageQueue_T* get_queue_by_label(const char* thread_label);
@@ -23,12 +23,18 @@
 
 #include "client_manager.h"
 #include "command_interface.h"
+#include "log_console.h"
+#include "log_maintenance.h"
+#include "log_network.h"
 #include "log_queue.h"
 #include "logger.h"
+#include "message_pool.h"
 #include "server_manager.h"
 #include "thread_registry.h"
 #include "utils.h"
 
+#define SERVICE_QUEUE_POP_BATCH 16  // Most messages service_thread_queue takes off a queue at once
+
 typedef enum WaitResult {
     APP_WAIT_SUCCESS = PLATFORM_WAIT_SUCCESS,    // 0
     APP_WAIT_TIMEOUT = PLATFORM_WAIT_TIMEOUT,    // 1
@@ -61,7 +67,8 @@ const ThreadConfig ThreadConfigTemplate = {
     .msg_processor = NULL,                 // No message processing by default
     .queue_process_interval_ms = 0,        // Check every loop
     .max_process_time_ms = 100,           // 100ms default
-    .msg_batch_size = 10                  // Process up to 10 messages per batch
+    .msg_batch_size = 10,                 // Process up to 10 messages per batch
+    .queue_mode = MESSAGE_QUEUE_MPMC      // Safe for any number of senders
 };
 
 ThreadRegistryError register_main_thread(void) {
@@ -79,6 +86,9 @@ ThreadRegistryError register_main_thread(void) {
         return reg_result;
     }
 
+    // The main thread takes its per-thread logger settings like any other
+    set_thread_log_file_from_config(main_thread.label);
+
     // Initialize message queue for main thread
     reg_result = init_queue(main_thread.label);
     if (reg_result != THREAD_REG_SUCCESS) {
@@ -315,6 +325,9 @@ void start_threads(void) {
     // Define all threads to start
     ThreadStartInfo threads_to_start[] = {
         { get_logger_thread(), true },             // Logger is essential
+        { get_log_console_thread(), false },       // Writes screen output so the terminal never stalls logging
+        { get_log_maintenance_thread(), false },   // Prunes rotated logs in the background
+        { get_log_network_thread(), false },       // Streams log lines to a collector, if configured
         // { get_watchdog_thread(), true },        // Watchdog is essential
         { get_server_thread(), false },            // Server thread is not essential
         { get_client_thread(), false },            // Add client thread
@@ -344,6 +357,14 @@ void start_threads(void) {
             }
         }
     }
+
+    // Further log writers, if configured; the logger writes the share of any that fail to start
+    for (uint32_t worker = 1; worker < logger_worker_count(); worker++) {
+        ThreadResult result = app_thread_create(get_logger_worker_thread(worker));
+        if (result != THREAD_SUCCESS) {
+            logger_log(LOG_ERROR, "Failed to create logger worker %u (error: %d)", worker, result);
+        }
+    }
 }
 
 static void* thread_wrapper(void* arg) {
@@ -429,6 +450,11 @@ static void* thread_wrapper(void* arg) {
             thread_args.label,
             app_error_get_message(THREAD_REGISTRY_DOMAIN, dereg_result));
     }
+
+    // Report what this thread's rate-limited log sites held back, then hand its log ring
+    // back once the logger has drained it
+    logger_rate_limit_flush();
+    log_queue_release_thread_ring();
     
     return (void*)(uintptr_t)(run_result);
 }
@@ -491,7 +517,7 @@ ThreadResult service_thread_queue(ThreadConfig* thread) {
     uint32_t start_time = get_time_ms();
     uint32_t messages_processed = 0;
     ThreadResult result = THREAD_SUCCESS;
-    Message_T message;
+    Message_T* messages[SERVICE_QUEUE_POP_BATCH];
 
     while (true) {
         // Check time limit
@@ -503,19 +529,31 @@ ThreadResult service_thread_queue(ThreadConfig* thread) {
         }
 
         // Check message batch limit
-        if (thread->msg_batch_size > 0 && messages_processed >= thread->msg_batch_size) {
-            break;
+        uint32_t wanted = SERVICE_QUEUE_POP_BATCH;
+        if (thread->msg_batch_size > 0) {
+            if (messages_processed >= thread->msg_batch_size) {
+                break;
+            }
+            if (thread->msg_batch_size - messages_processed < wanted) {
+                wanted = thread->msg_batch_size - messages_processed;
+            }
         }
 
-        // Try to get a message (non-blocking)
-        ThreadRegistryError queue_result = pop_message(thread->label, &message, 0);
+        // Take whatever is waiting, up to wanted, in one go (non-blocking)
+        uint32_t popped = 0;
+        ThreadRegistryError queue_result = pop_messages(thread->label, messages, wanted, 0, &popped);
         
         if (queue_result == THREAD_REG_QUEUE_EMPTY) {
             break;
         }
         else if (queue_result == THREAD_REG_SUCCESS) {
-            result = thread->msg_processor(thread, &message);
-            messages_processed++;
+            for (uint32_t i = 0; i < popped; i++) {
+                if (result == THREAD_SUCCESS) {
+                    result = thread->msg_processor(thread, messages[i]);
+                    messages_processed++;
+                }
+                message_release(messages[i]);  // The rest of the batch is dropped after a failure
+            }
             
             if (result != THREAD_SUCCESS) {
                 logger_log(LOG_ERROR, "Message processing failed in thread '%s': %d", 
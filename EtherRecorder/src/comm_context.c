@@ -9,6 +9,7 @@
 #include "thread_registry.h"
 #include "app_config.h"
 #include "logger.h"
+#include "message_pool.h"
 
 
 typedef struct HexDumpConfig {
@@ -46,6 +47,11 @@ void comm_context_cleanup_threads(CommContext* context) {
     PlatformThreadId threads[2] = {0};
     uint32_t thread_count = 0;
 
+    // The send thread may be parked on its queue; have it recheck for shutdown now
+    if (context->send_thread_id && context->send_queue_label[0] != '\0') {
+        wake_queue(context->send_queue_label);
+    }
+
     if (context->send_thread_id) {
         threads[thread_count++] = context->send_thread_id;
     }
@@ -77,6 +83,10 @@ PlatformErrorCode comm_context_create_threads(ThreadConfig* send_config,
     // Initialize hex dump configuration
     init_hex_dump_config();
 
+    // Either side closing the connection has to wake the send thread from its queue wait
+    strncpy(send_context->send_queue_label, send_config->label, MAX_THREAD_LABEL_LENGTH - 1);
+    strncpy(recv_context->send_queue_label, send_config->label, MAX_THREAD_LABEL_LENGTH - 1);
+
     // If relay is enabled, set up the foreign queue labels for receive thread
     if (recv_context->is_relay_enabled) {
         const char* client_send = "CLIENT.SEND";
@@ -120,6 +130,9 @@ static void comm_context_close(CommContext* context) {
         return;
     }
     platform_atomic_store_bool(context->connection_closed, true);
+    if (context->send_queue_label[0] != '\0') {
+        wake_queue(context->send_queue_label);
+    }
 }
 
 
@@ -211,47 +224,35 @@ static void log_buffered_data(const uint8_t* buffer, size_t length, int batch_by
     logger_log(LOG_INFO, "%d bytes received: bottom", batch_bytes);
 }
 
-static bool process_relay_data(CommContext* context, const char* buffer, size_t bytes_received) {
+/**
+ * @brief Passes received data on to the foreign queue, if relaying is enabled.
+ *
+ * Takes over the caller's reference to the message: it is either queued as
+ * received, with no copy, or released.
+ */
+static bool process_relay_data(CommContext* context, Message_T* message) {
     if (!context->is_relay_enabled || context->foreign_queue_label[0] == '\0') {
+        message_release(message);
         return true;  // Not an error, just no relay needed
     }
 
     MessageQueue_T* foreign_queue = get_queue_by_label(context->foreign_queue_label);
     if (!foreign_queue) {
+        message_release(message);
         return true;  // Queue not available yet, ignore
     }
 
-    const size_t max_content_size = sizeof(((Message_T*)0)->content);
-    const char* current_pos = buffer;
-    size_t remaining = bytes_received;
-
-    int chunk_count = 0;
-    while (remaining > 0) {
-        if (chunk_count >= 1) {
-            logger_log(LOG_ERROR, "Chunks in relay data %d", chunk_count);
-            return false;
-        }
-        Message_T message = {0};
-        message.header.type = MSG_TYPE_RELAY;
-        message.header.content_size = (remaining > max_content_size) ? max_content_size : remaining;
-        
-        memcpy(message.content, current_pos, message.header.content_size);
-        
-        if (!message_queue_push(foreign_queue, &message, DEFAULT_THREAD_WAIT_TIMEOUT_MS)) {
-            logger_log(LOG_ERROR, "Failed to relay message to foreign queue");
-            return false;
-        }
-
-        current_pos += message.header.content_size;
-        remaining -= message.header.content_size;
-        chunk_count++;
+    if (!message_queue_push(foreign_queue, message, DEFAULT_THREAD_WAIT_TIMEOUT_MS)) {
+        logger_log(LOG_ERROR, "Failed to relay message to foreign queue");
+        message_release(message);
+        return false;
     }
 
     return true;
 }
 
-static bool handle_receive(CommContext* context, char* buffer, size_t buffer_size) {
-    if (!context || !buffer) {
+static bool handle_receive(CommContext* context) {
+    if (!context) {
         return false;
     }
 
@@ -267,7 +268,7 @@ static bool handle_receive(CommContext* context, char* buffer, size_t buffer_siz
                 logger_log(LOG_ERROR, "Socket read timed out 10 times in a row");
                 return false;
             }
-            logger_log(LOG_INFO, "Socket read timed out");
+            logger_log_limited(LOG_INFO, "Socket read timed out");
             return true;  // Timeout is not an error condition
         }
         // Any other error should close the connection
@@ -275,26 +276,48 @@ static bool handle_receive(CommContext* context, char* buffer, size_t buffer_siz
         return false;
     }
 
+    // Receive straight into a pooled message big enough for everything pending, up to
+    // MESSAGE_MAX_CONTENT_SIZE, so one receive is relayed as one message and with no copy
+    size_t bytes_available = 0;
+    if (platform_socket_bytes_available(context->socket, &bytes_available) != PLATFORM_ERROR_SUCCESS ||
+        bytes_available == 0) {
+        bytes_available = MESSAGE_CONTENT_SIZE;  // Let the receive itself report what happened
+    }
+    if (bytes_available > MESSAGE_MAX_CONTENT_SIZE) {
+        bytes_available = MESSAGE_MAX_CONTENT_SIZE;
+    }
+    Message_T* message = message_alloc(MSG_TYPE_RELAY, bytes_available);
+    if (!message) {
+        return true;  // Reported by the pool; the data stays in the socket for now
+    }
+
     size_t bytes_received;
     PlatformErrorCode err = platform_socket_receive(context->socket,
-                                                    buffer,
-                                                    buffer_size,
+                                                    message->content,
+                                                    message->header.capacity,
                                                     &bytes_received);
     if (err != PLATFORM_ERROR_SUCCESS) {
+        message_release(message);
         comm_context_close(context);
         return false;
     }
+    message->header.content_size = bytes_received;
 
-    // Log the received data in hex format
-    log_buffered_data((const uint8_t*)buffer, bytes_received, (int)bytes_received);
+    // Relay before the hex dump, which would otherwise add its formatting time to the
+    // relay latency; the extra reference keeps the content readable once it is queued
+    message_retain(message);
 
     // Handle relay if enabled
-    if (!process_relay_data(context, buffer, bytes_received)) {
+    if (!process_relay_data(context, message)) {
         // a false return means an issue with the relay, not the receive
         // and it will have been reported on already
         ;
     }
 
+    // Log the received data in hex format
+    log_buffered_data(message->content, bytes_received, (int)bytes_received);
+    message_release(message);
+
     return true;
 }
 
@@ -375,10 +398,8 @@ void* comm_receive_thread(void* arg) {
 
     logger_log(LOG_INFO, "Receive thread started");
 
-    char buffer[4096];
-
     while (!comm_context_is_closed(context) && !shutdown_signalled()) {
-        if (!handle_receive(context, buffer, sizeof(buffer))) {
+        if (!handle_receive(context)) {
             break;  
         }
     }
@@ -419,6 +440,76 @@ void* comm_receive_thread(void* arg) {
 //     return (err == PLATFORM_ERROR_SUCCESS) ? THREAD_SUCCESS : THREAD_ERROR;
 // }
 
+/**
+ * @brief Sends buffers back to back in one vectored send, carrying on after partial sends.
+ * @return false on a send error, after which the connection has been closed.
+ */
+static bool send_buffers(CommContext* context, PlatformSocketBuffer* buffers, size_t count) {
+    size_t first = 0;
+
+    // Retry on partial sends, carrying on from the first byte not yet sent
+    while (first < count) {
+        size_t bytes_sent = 0;
+        PlatformErrorCode result = platform_socket_send_vectored(
+            context->socket,
+            buffers + first,
+            count - first,
+            &bytes_sent
+        );
+
+        if (result == PLATFORM_ERROR_SUCCESS && bytes_sent > 0) {
+            while (first < count && bytes_sent >= buffers[first].length) {
+                bytes_sent -= buffers[first].length;
+                first++;
+            }
+            if (first < count) {
+                buffers[first].data = (const uint8_t*)buffers[first].data + bytes_sent;
+                buffers[first].length -= bytes_sent;
+            }
+        }
+        else if (result == PLATFORM_ERROR_TIMEOUT) {
+            continue;  // Retry on timeout
+        }
+        else {
+            // Including a send that moved nothing, which would otherwise be retried for ever
+            logger_log(LOG_ERROR, "Send error occurred");
+            comm_context_close(context);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sends a batch of messages, as one vectored send over TCP.
+ *
+ * Over UDP each message goes in a datagram of its own, so message boundaries
+ * survive and no datagram grows past what the socket accepts.
+ *
+ * @return false on a send error, after which the connection has been closed.
+ */
+static bool send_message_batch(CommContext* context, Message_T* const* messages, uint32_t count) {
+    PlatformSocketBuffer buffers[PLATFORM_SOCKET_MAX_BUFFERS];
+    size_t used = 0;
+    for (uint32_t i = 0; i < count && used < PLATFORM_SOCKET_MAX_BUFFERS; i++) {
+        if (messages[i]->header.content_size > 0) {
+            buffers[used].data = messages[i]->content;
+            buffers[used].length = messages[i]->header.content_size;
+            used++;
+        }
+    }
+
+    if (context->is_tcp) {
+        return send_buffers(context, buffers, used);
+    }
+    for (size_t i = 0; i < used; i++) {
+        if (!send_buffers(context, &buffers[i], 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void* comm_send_thread(void* arg) {
     ThreadConfig* thread_config = (ThreadConfig*)arg;
     CommContext* context = (CommContext*)thread_config->data;
@@ -428,13 +519,16 @@ void* comm_send_thread(void* arg) {
 
     logger_log(LOG_INFO, "Send thread started");
 
-    Message_T message;
+    Message_T* messages[PLATFORM_SOCKET_MAX_BUFFERS];
     while (!comm_context_is_closed(context) && !shutdown_signalled()) {
-        // Simple non-blocking message pop
-        ThreadRegistryError queue_result = pop_message(thread_config->label, &message, 0);
+        // Block until there is something to send, taking everything pending up to one vectored
+        // send's worth. Closing the connection wakes the queue; a shutdown is seen within the park.
+        uint32_t count = 0;
+        ThreadRegistryError queue_result = pop_messages(thread_config->label, messages,
+                                                        PLATFORM_SOCKET_MAX_BUFFERS,
+                                                        COMM_SEND_PARK_MS, &count);
         
         if (queue_result == THREAD_REG_QUEUE_EMPTY) {
-            sleep_ms(10);
             continue;
         }
         
@@ -443,28 +537,12 @@ void* comm_send_thread(void* arg) {
             break;
         }
 
-        // Send complete message with retry on partial sends
-        size_t total_sent = 0;
-        while (total_sent < message.header.content_size) {
-            size_t bytes_sent = 0;
-            PlatformErrorCode result = platform_socket_send(
-                context->socket,
-                message.content + total_sent,
-                message.header.content_size - total_sent,
-                &bytes_sent
-            );
-
-            if (result == PLATFORM_ERROR_SUCCESS) {
-                total_sent += bytes_sent;
-            }
-            else if (result == PLATFORM_ERROR_TIMEOUT) {
-                continue;  // Retry on timeout
-            }
-            else {
-                logger_log(LOG_ERROR, "Send error occurred");
-                comm_context_close(context);
-                return NULL;
-            }
+        bool sent = send_message_batch(context, messages, count);
+        for (uint32_t i = 0; i < count; i++) {
+            message_release(messages[i]);
+        }
+        if (!sent) {
+            return NULL;
         }
     }
 
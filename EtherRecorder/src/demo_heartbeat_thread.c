@@ -14,7 +14,7 @@ static ThreadResult process_demo_message(ThreadConfig* thread, const Message_T*
     (void)thread; // Unused parameter
 
     if (message->header.type == MSG_TYPE_TEST) {
-        if (message->header.content_size > 0 && message->header.content_size <= sizeof(message->content)) {
+        if (message->header.content_size > 0 && message->header.content_size <= message->header.capacity) {
             logger_log(LOG_INFO, "Demo thread received message: %.*s", 
         
                 (int)message->header.content_size,
@@ -57,6 +57,7 @@ ThreadConfig* get_demo_heartbeat_thread(void) {
         demo_heartbeat_thread.label = "DEMO_HEARTBEAT";
         demo_heartbeat_thread.func = demo_heartbeat_function;
         demo_heartbeat_thread.msg_processor = process_demo_message;
+        demo_heartbeat_thread.queue_mode = MESSAGE_QUEUE_SPSC;  // Only the main thread sends to it
         initialized = true;
     }
     return &demo_heartbeat_thread;
@@ -7,6 +7,7 @@
 #include "platform_error.h"
 #include "platform_file.h"
 
+#include "message_pool.h"
 #include "message_types.h"
 #include "logger.h"
 #include "app_config.h"
@@ -165,9 +166,11 @@ void* file_reader_thread_function(void* arg) {
         return (void*)THREAD_ERROR_FILE_READ;
     }
 
-    // Use configured chunk size or default to MESSAGE_CONTENT_SIZE
-    size_t chunk_size = config->chunk_size > 0 ?
-        config->chunk_size : MESSAGE_CONTENT_SIZE;
+    // Use configured chunk size or default to MESSAGE_CONTENT_SIZE, up to the most a message holds
+    size_t chunk_size = config->chunk_size > 0 ? config->chunk_size : MESSAGE_CONTENT_SIZE;
+    if (chunk_size > MESSAGE_MAX_CONTENT_SIZE) {
+        chunk_size = MESSAGE_MAX_CONTENT_SIZE;
+    }
 
     // Read and send file contents in chunks
     size_t bytes_read;
@@ -175,41 +178,39 @@ void* file_reader_thread_function(void* arg) {
     uint32_t last_progress = get_time_ms();
 
     while (!shutdown_signalled()) {
-        uint8_t buffer[MESSAGE_CONTENT_SIZE];
-        error_code = platform_file_read(file, buffer, chunk_size, &bytes_read);
+        // Read straight into a pooled message, which the queue then carries as is
+        Message_T* message = message_alloc(MSG_TYPE_FILE_CHUNK, chunk_size);
+        if (!message) {
+            platform_file_close(file);
+            return (void*)THREAD_ERROR_OUT_OF_MEMORY;
+        }
+
+        error_code = platform_file_read(file, message->content, chunk_size, &bytes_read);
         if (error_code != PLATFORM_ERROR_SUCCESS) {
             char error_buffer[256];
             platform_get_error_message_from_code(error_code, error_buffer, sizeof(error_buffer));
             logger_log(LOG_ERROR, "Failed to read from file '%s': %s",
                 config->filepath, error_buffer);
+            message_release(message);
             platform_file_close(file);
             return (void*)THREAD_ERROR_FILE_READ;
         }
 
         if (bytes_read == 0) {
+            message_release(message);
             break;  // End of file
         }
 
-        // Create message on stack and copy into queue's pre-allocated buffer
-        Message_T message = { 0 };
-        message.header.type = MSG_TYPE_FILE_CHUNK;
-        message.header.content_size = bytes_read;
-
-        if (message.header.content_size > MESSAGE_CONTENT_SIZE) {
-            logger_log(LOG_ERROR, "Chunk size exceeds message content buffer");
-            platform_file_close(file);
-            return (void*)THREAD_ERROR_BUFFER_OVERFLOW;
-        }
-
-        memcpy(message.content, buffer, bytes_read);
+        message->header.content_size = bytes_read;
 
         ThreadRegistryError send_result = push_message(
             config->foreign_thread_label,
-            &message,
+            message,
             config->queue_timeout_ms
         );
 
         if (send_result != THREAD_REG_SUCCESS) {
+            message_release(message);
             platform_file_close(file);
             return (void*)THREAD_ERROR_QUEUE_FULL;
         }
@@ -0,0 +1,579 @@
+/**
+ * @file log_archive.c
+ * @brief Block-framed, seekable compression of rotated log files.
+ *
+ * Blocks are compressed with a small LZ77 coder in the style of LZ4: a
+ * sequence is a token byte (literal count in the high nibble, match length
+ * less 4 in the low nibble, 15 meaning more length bytes follow), the
+ * literals, then a 2-byte offset back into the block. The final sequence has
+ * literals only. Log text is highly repetitive, so this greedy single-probe
+ * coder gets most of the available gain at very little CPU cost.
+ */
+
+#include "log_archive.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform_path.h"
+
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 16
+#define BLOCK_HEADER_SIZE 24
+#define INDEX_ENTRY_SIZE 24
+#define TRAILER_SIZE 16
+#define MAX_BLOCK_SIZE 0x1000000      // Largest block a reader will accept (16 MB)
+
+#define LZ_HASH_BITS 14
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 0xFFFF
+#define LZ_LAST_LITERALS 5            // A block always ends with this many literals
+#define LZ_MATCH_LIMIT 12             // No match starts this close to the end of a block
+
+#define TIMESTAMP_LENGTH 19           // "YYYY-MM-DD HH:MM:SS"
+
+static const char ARCHIVE_MAGIC[4] = { 'E', 'R', 'L', 'Z' };
+static const char TRAILER_MAGIC[4] = { 'E', 'R', 'L', 'X' };
+
+typedef struct BlockIndexEntry {
+    uint64_t offset;
+    int64_t min_time;
+    int64_t max_time;
+} BlockIndexEntry;
+
+static void put_u32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static void put_u64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+static uint64_t get_u64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+static uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/* ---- Log times ---- */
+
+static bool parse_digits(const char* text, int count, int* value) {
+    *value = 0;
+    for (int i = 0; i < count; i++) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        *value = *value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+static int64_t days_from_civil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned year_of_era = (unsigned)(year - era * 400);
+    unsigned day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + (int64_t)day_of_era - 719468;
+}
+
+// Parses exactly TIMESTAMP_LENGTH characters; the date and time are split by a space, or a T as in JSON lines
+static bool parse_timestamp(const char* text, int64_t* seconds) {
+    int year, month, day, hour, minute, second;
+    if (!parse_digits(text, 4, &year) || text[4] != '-' ||
+        !parse_digits(text + 5, 2, &month) || text[7] != '-' ||
+        !parse_digits(text + 8, 2, &day) || (text[10] != ' ' && text[10] != 'T') ||
+        !parse_digits(text + 11, 2, &hour) || text[13] != ':' ||
+        !parse_digits(text + 14, 2, &minute) || text[16] != ':' ||
+        !parse_digits(text + 17, 2, &second)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    *seconds = days_from_civil(year, (unsigned)month, (unsigned)day) * 86400 +
+               hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+bool log_archive_parse_time(const char* text, int64_t* seconds) {
+    if (!text || !seconds) {
+        return false;
+    }
+    for (int i = 0; i < TIMESTAMP_LENGTH; i++) {
+        if (text[i] == '\0') return false;
+    }
+    return parse_timestamp(text, seconds);
+}
+
+/**
+ * @brief Gets the log time of a line of the form "<index> YYYY-MM-DD HH:MM:SS...", or of
+ *        the JSON form {"index":<index>,"timestamp":"YYYY-MM-DDTHH:MM:SS...
+ */
+static bool line_log_time(const uint8_t* line, size_t length, int64_t* seconds) {
+    static const char json_index[] = "{\"index\":";
+    static const char json_timestamp[] = ",\"timestamp\":\"";
+    size_t i = 0;
+    bool json = length > sizeof(json_index) - 1 && memcmp(line, json_index, sizeof(json_index) - 1) == 0;
+    if (json) {
+        i = sizeof(json_index) - 1;
+    }
+    size_t digits = i;
+    while (i < length && line[i] >= '0' && line[i] <= '9') {
+        i++;
+    }
+    if (i == digits || i >= length) {
+        return false;
+    }
+    if (json) {
+        if (length - i < sizeof(json_timestamp) - 1 ||
+            memcmp(line + i, json_timestamp, sizeof(json_timestamp) - 1) != 0) {
+            return false;
+        }
+        i += sizeof(json_timestamp) - 1;
+    } else if (line[i++] != ' ') {
+        return false;
+    }
+    if (length - i < TIMESTAMP_LENGTH) {
+        return false;
+    }
+    return parse_timestamp((const char*)line + i, seconds);
+}
+
+/* ---- Block coder ---- */
+
+static size_t put_length(uint8_t* out, size_t length) {
+    size_t written = 0;
+    while (length >= 255) {
+        out[written++] = 255;
+        length -= 255;
+    }
+    out[written++] = (uint8_t)length;
+    return written;
+}
+
+/**
+ * @brief Appends one sequence to the output, or fails if it would not fit.
+ */
+static bool put_sequence(uint8_t* out, size_t capacity, size_t* out_pos,
+                         const uint8_t* literals, size_t literal_count,
+                         size_t offset, size_t match_length) {
+    size_t worst = 1 + literal_count / 255 + 1 + literal_count + 2 + match_length / 255 + 1;
+    if (capacity - *out_pos < worst) {
+        return false;
+    }
+
+    uint8_t* token = out + (*out_pos)++;
+    *token = (uint8_t)((literal_count < 15 ? literal_count : 15) << 4);
+    if (literal_count >= 15) {
+        *out_pos += put_length(out + *out_pos, literal_count - 15);
+    }
+    memcpy(out + *out_pos, literals, literal_count);
+    *out_pos += literal_count;
+
+    if (match_length == 0) {
+        return true;  // Final sequence, literals only
+    }
+
+    out[(*out_pos)++] = (uint8_t)offset;
+    out[(*out_pos)++] = (uint8_t)(offset >> 8);
+    size_t length_code = match_length - LZ_MIN_MATCH;
+    *token |= (uint8_t)(length_code < 15 ? length_code : 15);
+    if (length_code >= 15) {
+        *out_pos += put_length(out + *out_pos, length_code - 15);
+    }
+    return true;
+}
+
+/**
+ * @brief Compresses a block.
+ * @return The compressed size, or 0 if it would not fit in capacity.
+ */
+static size_t lz_compress(const uint8_t* in, size_t length, uint8_t* out, size_t capacity) {
+    static uint32_t table[1 << LZ_HASH_BITS];  // Only the maintenance thread compresses
+    memset(table, 0, sizeof(table));
+
+    size_t out_pos = 0;
+    size_t anchor = 0;
+    size_t pos = 0;
+
+    while (length >= LZ_MATCH_LIMIT && pos <= length - LZ_MATCH_LIMIT) {
+        uint32_t sequence = read32(in + pos);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = (uint32_t)pos;
+
+        if (candidate >= pos || pos - candidate > LZ_MAX_OFFSET || read32(in + candidate) != sequence) {
+            pos++;
+            continue;
+        }
+
+        size_t match_length = LZ_MIN_MATCH;
+        size_t limit = length - LZ_LAST_LITERALS;
+        while (pos + match_length < limit && in[candidate + match_length] == in[pos + match_length]) {
+            match_length++;
+        }
+
+        if (!put_sequence(out, capacity, &out_pos, in + anchor, pos - anchor, pos - candidate, match_length)) {
+            return 0;
+        }
+        pos += match_length;
+        anchor = pos;
+    }
+
+    if (!put_sequence(out, capacity, &out_pos, in + anchor, length - anchor, 0, 0)) {
+        return 0;
+    }
+    return out_pos;
+}
+
+static bool get_length(const uint8_t* in, size_t length, size_t* pos, size_t* value) {
+    uint8_t byte;
+    do {
+        if (*pos >= length) return false;
+        byte = in[(*pos)++];
+        *value += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Decompresses a block, checking every read and write against its bounds.
+ */
+static bool lz_decompress(const uint8_t* in, size_t length, uint8_t* out, size_t raw_size) {
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+
+    while (in_pos < length) {
+        uint8_t token = in[in_pos++];
+
+        size_t literal_count = token >> 4;
+        if (literal_count == 15 && !get_length(in, length, &in_pos, &literal_count)) return false;
+        if (literal_count > length - in_pos || literal_count > raw_size - out_pos) return false;
+        memcpy(out + out_pos, in + in_pos, literal_count);
+        in_pos += literal_count;
+        out_pos += literal_count;
+
+        if (in_pos == length) {
+            break;  // Final sequence
+        }
+
+        if (length - in_pos < 2) return false;
+        size_t offset = (size_t)in[in_pos] | ((size_t)in[in_pos + 1] << 8);
+        in_pos += 2;
+        if (offset == 0 || offset > out_pos) return false;
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15 && !get_length(in, length, &in_pos, &match_length)) return false;
+        match_length += LZ_MIN_MATCH;
+        if (match_length > raw_size - out_pos) return false;
+
+        // Byte by byte, as a match may overlap the bytes it produces
+        for (size_t i = 0; i < match_length; i++, out_pos++) {
+            out[out_pos] = out[out_pos - offset];
+        }
+    }
+    return out_pos == raw_size;
+}
+
+/* ---- Writing ---- */
+
+/**
+ * @brief Finds the range of log times of the lines in a block.
+ * @param current_time In: time of the line before the block. Out: time of its last line.
+ * @param have_time In/out: whether current_time has been set by any line yet.
+ */
+static void block_time_range(const uint8_t* data, size_t length, int64_t* current_time, bool* have_time,
+                             int64_t* min_time, int64_t* max_time) {
+    *min_time = INT64_MAX;
+    *max_time = INT64_MIN;
+
+    size_t start = 0;
+    while (start < length) {
+        const uint8_t* newline = memchr(data + start, '\n', length - start);
+        size_t end = newline ? (size_t)(newline - data) : length;
+
+        int64_t line_time;
+        if (line_log_time(data + start, end - start, &line_time)) {
+            *current_time = line_time;
+            *have_time = true;
+        }
+        if (*have_time) {
+            if (*current_time < *min_time) *min_time = *current_time;
+            if (*current_time > *max_time) *max_time = *current_time;
+        }
+        start = end + 1;
+    }
+
+    if (*min_time > *max_time) {
+        *min_time = *max_time = *current_time;  // No timed line yet
+    }
+}
+
+static bool write_archive(FILE* in, FILE* out) {
+    uint8_t* raw = malloc(LOG_ARCHIVE_BLOCK_SIZE);
+    uint8_t* packed = malloc(LOG_ARCHIVE_BLOCK_SIZE);
+    BlockIndexEntry* index = NULL;
+    size_t block_count = 0;
+    size_t index_capacity = 0;
+    bool success = raw && packed;
+
+    uint8_t header[ARCHIVE_HEADER_SIZE] = {0};
+    memcpy(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    put_u32(header + 4, ARCHIVE_VERSION);
+    put_u32(header + 8, LOG_ARCHIVE_BLOCK_SIZE);
+    success = success && fwrite(header, 1, sizeof(header), out) == sizeof(header);
+
+    uint64_t offset = ARCHIVE_HEADER_SIZE;
+    size_t filled = 0;
+    int64_t current_time = 0;
+    bool have_time = false;
+    bool at_end = false;
+
+    while (success && !(at_end && filled == 0)) {
+        size_t wanted = LOG_ARCHIVE_BLOCK_SIZE - filled;
+        size_t got = fread(raw + filled, 1, wanted, in);
+        filled += got;
+        if (got < wanted) {
+            if (ferror(in)) {
+                success = false;
+                break;
+            }
+            at_end = true;
+        }
+        if (filled == 0) {
+            break;
+        }
+
+        // Blocks end on a line boundary unless a single line fills the block
+        size_t block_length = filled;
+        if (!at_end) {
+            for (size_t i = filled; i > 0; i--) {
+                if (raw[i - 1] == '\n') {
+                    block_length = i;
+                    break;
+                }
+            }
+        }
+
+        BlockIndexEntry entry = { .offset = offset };
+        block_time_range(raw, block_length, &current_time, &have_time, &entry.min_time, &entry.max_time);
+
+        size_t stored_size = lz_compress(raw, block_length, packed, block_length);
+        const uint8_t* stored = packed;
+        if (stored_size == 0 || stored_size >= block_length) {
+            stored_size = block_length;  // Incompressible, keep as is
+            stored = raw;
+        }
+
+        uint8_t block_header[BLOCK_HEADER_SIZE];
+        put_u32(block_header, (uint32_t)block_length);
+        put_u32(block_header + 4, (uint32_t)stored_size);
+        put_u64(block_header + 8, (uint64_t)entry.min_time);
+        put_u64(block_header + 16, (uint64_t)entry.max_time);
+        if (fwrite(block_header, 1, sizeof(block_header), out) != sizeof(block_header) ||
+            fwrite(stored, 1, stored_size, out) != stored_size) {
+            success = false;
+            break;
+        }
+        offset += sizeof(block_header) + stored_size;
+
+        if (block_count == index_capacity) {
+            size_t capacity = index_capacity ? index_capacity * 2 : 64;
+            BlockIndexEntry* grown = realloc(index, capacity * sizeof(*grown));
+            if (!grown) {
+                success = false;
+                break;
+            }
+            index = grown;
+            index_capacity = capacity;
+        }
+        index[block_count++] = entry;
+
+        memmove(raw, raw + block_length, filled - block_length);
+        filled -= block_length;
+    }
+
+    for (size_t i = 0; success && i < block_count; i++) {
+        uint8_t index_entry[INDEX_ENTRY_SIZE];
+        put_u64(index_entry, index[i].offset);
+        put_u64(index_entry + 8, (uint64_t)index[i].min_time);
+        put_u64(index_entry + 16, (uint64_t)index[i].max_time);
+        success = fwrite(index_entry, 1, sizeof(index_entry), out) == sizeof(index_entry);
+    }
+
+    if (success) {
+        uint8_t trailer[TRAILER_SIZE];
+        put_u64(trailer, offset);
+        put_u32(trailer + 8, (uint32_t)block_count);
+        memcpy(trailer + 12, TRAILER_MAGIC, sizeof(TRAILER_MAGIC));
+        success = fwrite(trailer, 1, sizeof(trailer), out) == sizeof(trailer);
+    }
+
+    free(index);
+    free(packed);
+    free(raw);
+    return success;
+}
+
+bool log_archive_compress(const char* source_path, const char* archive_path) {
+    if (!source_path || !archive_path) {
+        return false;
+    }
+
+    // Written under a temporary name so a partial archive is never mistaken for a whole one
+    char part_path[MAX_PATH_LEN];
+    if ((size_t)snprintf(part_path, sizeof(part_path), "%s.part", archive_path) >= sizeof(part_path)) {
+        return false;
+    }
+
+    FILE* in = NULL;
+    if (platform_fopen(&in, source_path, "rb") != PLATFORM_ERROR_SUCCESS || !in) {
+        return false;
+    }
+    FILE* out = NULL;
+    if (platform_fopen(&out, part_path, "wb") != PLATFORM_ERROR_SUCCESS || !out) {
+        fclose(in);
+        return false;
+    }
+
+    bool success = write_archive(in, out);
+    fclose(in);
+    success = (fclose(out) == 0) && success;
+
+    if (success) {
+        remove(archive_path);  // rename does not replace an existing file on Windows
+        success = rename(part_path, archive_path) == 0;
+    }
+    if (!success) {
+        remove(part_path);
+    }
+    return success;
+}
+
+/* ---- Reading ---- */
+
+static bool read_at(FILE* file, uint64_t offset, uint8_t* buffer, size_t size) {
+    return offset <= INT64_MAX &&
+           platform_fseek(file, (int64_t)offset, SEEK_SET) == PLATFORM_ERROR_SUCCESS &&
+           fread(buffer, 1, size, file) == size;
+}
+
+/**
+ * @brief Writes the lines of a decompressed block whose log time lies in [from, to].
+ */
+static bool write_lines_in_range(const uint8_t* data, size_t length, int64_t block_start_time,
+                                 int64_t from, int64_t to, FILE* out) {
+    int64_t current_time = block_start_time;
+    size_t start = 0;
+
+    while (start < length) {
+        const uint8_t* newline = memchr(data + start, '\n', length - start);
+        size_t end = newline ? (size_t)(newline - data) + 1 : length;
+
+        int64_t line_time;
+        if (line_log_time(data + start, end - start, &line_time)) {
+            current_time = line_time;
+        }
+        if (current_time >= from && current_time <= to &&
+            fwrite(data + start, 1, end - start, out) != end - start) {
+            return false;
+        }
+        start = end;
+    }
+    return true;
+}
+
+bool log_archive_read_range(const char* archive_path, int64_t from, int64_t to, FILE* out) {
+    if (!archive_path || !out) {
+        return false;
+    }
+
+    FILE* file = NULL;
+    if (platform_fopen(&file, archive_path, "rb") != PLATFORM_ERROR_SUCCESS || !file) {
+        return false;
+    }
+
+    uint8_t header[ARCHIVE_HEADER_SIZE];
+    uint8_t trailer[TRAILER_SIZE];
+    bool success = read_at(file, 0, header, sizeof(header)) &&
+                   memcmp(header, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) == 0 &&
+                   get_u32(header + 4) == ARCHIVE_VERSION &&
+                   platform_fseek(file, -(int64_t)TRAILER_SIZE, SEEK_END) == PLATFORM_ERROR_SUCCESS &&
+                   fread(trailer, 1, sizeof(trailer), file) == sizeof(trailer) &&
+                   memcmp(trailer + 12, TRAILER_MAGIC, sizeof(TRAILER_MAGIC)) == 0;
+
+    uint64_t index_offset = success ? get_u64(trailer) : 0;
+    uint32_t block_count = success ? get_u32(trailer + 8) : 0;
+    uint8_t* index = success ? malloc((size_t)block_count * INDEX_ENTRY_SIZE + 1) : NULL;
+    success = success && index &&
+              read_at(file, index_offset, index, (size_t)block_count * INDEX_ENTRY_SIZE);
+
+    uint8_t* stored = NULL;
+    uint8_t* raw = NULL;
+    size_t buffer_size = 0;
+
+    for (uint32_t i = 0; success && i < block_count; i++) {
+        const uint8_t* entry = index + (size_t)i * INDEX_ENTRY_SIZE;
+        int64_t min_time = (int64_t)get_u64(entry + 8);
+        int64_t max_time = (int64_t)get_u64(entry + 16);
+        if (max_time < from || min_time > to) {
+            continue;  // The point of the index: this block is never read
+        }
+
+        uint8_t block_header[BLOCK_HEADER_SIZE];
+        if (!read_at(file, get_u64(entry), block_header, sizeof(block_header))) {
+            success = false;
+            break;
+        }
+        size_t raw_size = get_u32(block_header);
+        size_t stored_size = get_u32(block_header + 4);
+        if (raw_size > MAX_BLOCK_SIZE || stored_size > raw_size) {
+            success = false;
+            break;
+        }
+
+        if (raw_size > buffer_size) {
+            free(stored);
+            free(raw);
+            stored = malloc(raw_size);
+            raw = malloc(raw_size);
+            buffer_size = (stored && raw) ? raw_size : 0;
+            if (!buffer_size) {
+                success = false;
+                break;
+            }
+        }
+
+        if (fread(stored, 1, stored_size, file) != stored_size) {
+            success = false;
+            break;
+        }
+        const uint8_t* data = stored;
+        if (stored_size < raw_size) {
+            if (!lz_decompress(stored, stored_size, raw, raw_size)) {
+                success = false;
+                break;
+            }
+            data = raw;
+        }
+        success = write_lines_in_range(data, raw_size, min_time, from, to, out);
+    }
+
+    free(raw);
+    free(stored);
+    free(index);
+    fclose(file);
+    return success;
+}
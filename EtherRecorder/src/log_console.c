@@ -0,0 +1,106 @@
+/**
+ * @file log_console.c
+ * @brief Console log sink, writing log lines to stderr on its own thread.
+ */
+
+#include "log_console.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "platform_path.h"
+#include "platform_threads.h"
+#include "platform_time.h"
+
+#include "app_config.h"
+#include "logger.h"
+#include "utils.h"
+
+#define LOG_CONSOLE_DEFAULT_BUFFER 0x40000   // Default ring (256 KB)
+#define LOG_CONSOLE_PARK_MS 100              // Longest wait for lines, so a shutdown is still noticed
+#define LOG_CONSOLE_DROP_REPORT_MS 5000      // Shortest gap between reports of dropped lines
+
+extern const ThreadConfig ThreadConfigTemplate;
+
+static LogLineRing g_ring;
+
+/**
+ * @brief Writes out the lines waiting in the ring, a batch at a time.
+ * @return The bytes written.
+ */
+static size_t write_waiting_lines(char* buffer) {
+    size_t total = 0;
+    uint32_t next_tail;
+    size_t length;
+
+    while ((length = log_line_ring_peek(&g_ring, buffer, LOG_CONSOLE_WRITE_SIZE, &next_tail)) > 0) {
+        platform_write(stderr, buffer, length);
+        fflush(stderr);
+        log_line_ring_consume(&g_ring, next_tail);
+        total += length;
+    }
+    log_line_ring_consume(&g_ring, next_tail);  // Past any line too long to write whole
+    return total;
+}
+
+static void* log_console_function(void* arg) {
+    (void)arg;
+
+    int buffer_size = get_config_int("logger", "log_console_buffer_size", LOG_CONSOLE_DEFAULT_BUFFER);
+    if (!log_line_ring_init(&g_ring, buffer_size > 0 ? (uint32_t)buffer_size : 0)) {
+        logger_log(LOG_WARN, "Console log sink could not allocate its buffer, writing to the screen directly");
+        return (void*)THREAD_SUCCESS;
+    }
+
+    static char buffer[LOG_CONSOLE_WRITE_SIZE];
+    uint64_t dropped_reported = 0;
+    uint32_t last_report = 0;
+    platform_get_tick_count(&last_report);
+
+    logger_attach_console_ring(&g_ring);
+    logger_log(LOG_INFO, "Console log sink started with a %u byte buffer", g_ring.size);
+
+    while (!shutdown_signalled()) {
+        if (write_waiting_lines(buffer) == 0) {
+            log_line_ring_wait(&g_ring, LOG_CONSOLE_PARK_MS);
+        }
+
+        // Each report carries every line dropped since the last, however long that was held back
+        uint64_t dropped = log_line_ring_dropped(&g_ring);
+        uint32_t now = 0;
+        platform_get_tick_count(&now);
+        if (dropped != dropped_reported && now - last_report >= LOG_CONSOLE_DROP_REPORT_MS) {
+            logger_log(LOG_WARN, "%llu console lines dropped, the terminal could not keep up",
+                       (unsigned long long)(dropped - dropped_reported));
+            dropped_reported = dropped;
+            last_report = now;
+        }
+    }
+
+    uint64_t dropped = log_line_ring_dropped(&g_ring);
+    if (dropped != dropped_reported) {
+        logger_log(LOG_WARN, "%llu console lines dropped, the terminal could not keep up",
+                   (unsigned long long)(dropped - dropped_reported));
+    }
+    logger_log(LOG_INFO, "Console log sink shutting down");
+
+    // Hand the screen back to the logger, then write out what was queued before it took over
+    write_waiting_lines(buffer);
+    logger_attach_console_ring(NULL);
+    write_waiting_lines(buffer);
+    log_line_ring_free(&g_ring);
+    return (void*)THREAD_SUCCESS;
+}
+
+ThreadConfig* get_log_console_thread(void) {
+    static ThreadConfig log_console_thread;
+    static bool initialized = false;
+
+    if (!initialized) {
+        log_console_thread = ThreadConfigTemplate;
+        log_console_thread.label = LOG_CONSOLE_THREAD_LABEL;
+        log_console_thread.func = log_console_function;
+        initialized = true;
+    }
+    return &log_console_thread;
+}
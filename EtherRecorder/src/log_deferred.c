@@ -0,0 +1,371 @@
+/**
+ * @file log_deferred.c
+ * @brief Capture and later rendering of printf-style log arguments.
+ *
+ * The capture side walks the format string once, pulling each argument off
+ * the va_list with the type its conversion specification implies, and stores
+ * the raw bytes back to back. Strings are copied by value since the caller's
+ * buffer may be gone by the time the logger thread renders the entry.
+ *
+ * The render side walks the same format string again and hands every
+ * conversion specification, verbatim, to snprintf with the stored value.
+ */
+
+#include "log_deferred.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_SPEC_LENGTH 64  // Longest single conversion specification we will copy
+
+typedef enum ArgClass {
+    ARG_NONE,         // "%%" - consumes no argument
+    ARG_INT,          // int, and anything promoted to it (char, short)
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_INTMAX,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,       // float is promoted to double
+    ARG_LONG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER,
+    ARG_UNSUPPORTED   // %n, wide characters, unknown conversions
+} ArgClass;
+
+typedef struct FormatSpec {
+    const char* start;     // Points at the introducing '%'
+    const char* end;       // One past the conversion character
+    bool width_star;       // Width supplied as an int argument
+    bool has_precision;
+    bool precision_star;   // Precision supplied as an int argument
+    int precision;         // Literal precision, valid if has_precision && !precision_star
+    const char* length;    // Length modifier (hh, h, l, ll, j, z, t, L)
+    size_t length_len;
+    char conversion;
+    ArgClass arg_class;
+} FormatSpec;
+
+typedef struct ArgCursor {
+    uint8_t* data;
+    size_t size;
+    size_t used;
+} ArgCursor;
+
+static bool length_is(const FormatSpec* spec, const char* modifier) {
+    return spec->length_len == strlen(modifier) &&
+           strncmp(spec->length, modifier, spec->length_len) == 0;
+}
+
+static ArgClass classify_integer(const FormatSpec* spec) {
+    if (spec->length_len == 0 || length_is(spec, "h") || length_is(spec, "hh")) return ARG_INT;
+    if (length_is(spec, "l"))  return ARG_LONG;
+    if (length_is(spec, "ll")) return ARG_LONG_LONG;
+    if (length_is(spec, "j"))  return ARG_INTMAX;
+    if (length_is(spec, "z"))  return ARG_SIZE;
+    if (length_is(spec, "t"))  return ARG_PTRDIFF;
+    return ARG_UNSUPPORTED;
+}
+
+static ArgClass classify(const FormatSpec* spec) {
+    switch (spec->conversion) {
+        case '%':
+            return ARG_NONE;
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            return classify_integer(spec);
+        case 'c':
+            return spec->length_len == 0 ? ARG_INT : ARG_UNSUPPORTED;
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A':
+            if (spec->length_len == 0 || length_is(spec, "l")) return ARG_DOUBLE;
+            if (length_is(spec, "L")) return ARG_LONG_DOUBLE;
+            return ARG_UNSUPPORTED;
+        case 's':
+            return spec->length_len == 0 ? ARG_STRING : ARG_UNSUPPORTED;
+        case 'p':
+            return spec->length_len == 0 ? ARG_POINTER : ARG_UNSUPPORTED;
+        default:
+            return ARG_UNSUPPORTED;
+    }
+}
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Parses one conversion specification starting at the '%'.
+ * @return Pointer to the first character after the specification.
+ */
+static const char* parse_spec(const char* p, FormatSpec* spec) {
+    spec->start = p++;
+
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') p++;
+
+    spec->width_star = (*p == '*');
+    if (spec->width_star) {
+        p++;
+    } else {
+        while (is_digit(*p)) p++;
+    }
+
+    spec->has_precision = (*p == '.');
+    spec->precision_star = false;
+    spec->precision = 0;
+    if (spec->has_precision) {
+        p++;
+        if (*p == '*') {
+            spec->precision_star = true;
+            p++;
+        } else {
+            while (is_digit(*p)) {
+                spec->precision = spec->precision * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+
+    spec->length = p;
+    if ((p[0] == 'h' && p[1] == 'h') || (p[0] == 'l' && p[1] == 'l')) {
+        p += 2;
+    } else if (*p == 'h' || *p == 'l' || *p == 'j' || *p == 'z' || *p == 't' || *p == 'L') {
+        p++;
+    }
+    spec->length_len = (size_t)(p - spec->length);
+
+    spec->conversion = *p;
+    if (*p) p++;
+    spec->end = p;
+    spec->arg_class = classify(spec);
+    return p;
+}
+
+static bool put_bytes(ArgCursor* cursor, const void* src, size_t len) {
+    if (len > cursor->size - cursor->used) {
+        return false;
+    }
+    memcpy(cursor->data + cursor->used, src, len);
+    cursor->used += len;
+    return true;
+}
+
+static bool get_bytes(ArgCursor* cursor, void* dst, size_t len) {
+    if (len > cursor->size - cursor->used) {
+        return false;
+    }
+    memcpy(dst, cursor->data + cursor->used, len);
+    cursor->used += len;
+    return true;
+}
+
+#define CAPTURE_VALUE(type) \
+    do { type value_ = va_arg(args, type); ok = put_bytes(&cursor, &value_, sizeof(value_)); } while (0)
+
+int log_deferred_capture(const char* format, va_list args, uint8_t* buffer, size_t size) {
+    if (!format || !buffer) {
+        return -1;
+    }
+
+    ArgCursor cursor = { buffer, size, 0 };
+    const char* p = format;
+
+    while (*p) {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+
+        FormatSpec spec;
+        p = parse_spec(p, &spec);
+        if (spec.arg_class == ARG_UNSUPPORTED) {
+            return -1;
+        }
+        if (spec.arg_class == ARG_NONE) {
+            continue;
+        }
+
+        bool ok = true;
+        if (spec.width_star) {
+            CAPTURE_VALUE(int);
+        }
+
+        int precision = spec.has_precision ? spec.precision : -1;
+        if (ok && spec.precision_star) {
+            precision = va_arg(args, int);
+            ok = put_bytes(&cursor, &precision, sizeof(precision));
+        }
+        if (!ok) {
+            return -1;
+        }
+
+        switch (spec.arg_class) {
+            case ARG_INT:         CAPTURE_VALUE(int); break;
+            case ARG_LONG:        CAPTURE_VALUE(long); break;
+            case ARG_LONG_LONG:   CAPTURE_VALUE(long long); break;
+            case ARG_INTMAX:      CAPTURE_VALUE(intmax_t); break;
+            case ARG_SIZE:        CAPTURE_VALUE(size_t); break;
+            case ARG_PTRDIFF:     CAPTURE_VALUE(ptrdiff_t); break;
+            case ARG_DOUBLE:      CAPTURE_VALUE(double); break;
+            case ARG_LONG_DOUBLE: CAPTURE_VALUE(long double); break;
+            case ARG_POINTER:     CAPTURE_VALUE(void*); break;
+            case ARG_STRING: {
+                // A null pointer is recorded as such so the C library renders it its own way
+                const char* str = va_arg(args, const char*);
+                uint8_t present = (str != NULL);
+                ok = put_bytes(&cursor, &present, sizeof(present));
+                if (ok && str) {
+                    // A precision bounds the read; the source need not be terminated
+                    size_t len = 0;
+                    if (precision >= 0) {
+                        while (len < (size_t)precision && str[len]) len++;
+                    } else {
+                        len = strlen(str);
+                    }
+                    const char terminator = '\0';
+                    ok = put_bytes(&cursor, str, len) && put_bytes(&cursor, &terminator, 1);
+                }
+                break;
+            }
+            default:
+                return -1;
+        }
+
+        if (!ok) {
+            return -1;
+        }
+    }
+
+    return (int)cursor.used;
+}
+
+/**
+ * @brief Appends literal text, truncating the same way vsnprintf would.
+ */
+static void append_literal(char* out, size_t out_size, size_t* total, const char* text, size_t len) {
+    if (out_size > 0 && *total < out_size - 1) {
+        size_t room = out_size - 1 - *total;
+        size_t copy = len < room ? len : room;
+        memcpy(out + *total, text, copy);
+        out[*total + copy] = '\0';
+    }
+    *total += len;
+}
+
+#define RENDER_VALUE(value) \
+    (star_count == 0 ? snprintf(dst, dst_size, spec_text, value) : \
+     star_count == 1 ? snprintf(dst, dst_size, spec_text, stars[0], value) : \
+                       snprintf(dst, dst_size, spec_text, stars[0], stars[1], value))
+
+#define READ_AND_RENDER(type) \
+    do { type value_; if (!get_bytes(&cursor, &value_, sizeof(value_))) return -1; \
+         written = RENDER_VALUE(value_); } while (0)
+
+int log_deferred_render(char* out, size_t out_size, const char* format,
+                        const uint8_t* args, size_t args_size) {
+    if (!format || (!args && args_size > 0)) {
+        return -1;
+    }
+
+    ArgCursor cursor = { (uint8_t*)args, args_size, 0 };
+    size_t total = 0;
+    const char* p = format;
+
+    if (out_size > 0) {
+        out[0] = '\0';
+    }
+
+    while (*p) {
+        const char* literal = p;
+        while (*p && *p != '%') p++;
+        if (p != literal) {
+            append_literal(out, out_size, &total, literal, (size_t)(p - literal));
+        }
+        if (!*p) {
+            break;
+        }
+
+        FormatSpec spec;
+        p = parse_spec(p, &spec);
+        if (spec.arg_class == ARG_UNSUPPORTED) {
+            return -1;
+        }
+        if (spec.arg_class == ARG_NONE) {
+            append_literal(out, out_size, &total, "%", 1);
+            continue;
+        }
+
+        size_t spec_len = (size_t)(spec.end - spec.start);
+        if (spec_len >= MAX_SPEC_LENGTH) {
+            return -1;
+        }
+        char spec_text[MAX_SPEC_LENGTH];
+        memcpy(spec_text, spec.start, spec_len);
+        spec_text[spec_len] = '\0';
+
+        int stars[2] = { 0, 0 };
+        int star_count = 0;
+        if (spec.width_star && !get_bytes(&cursor, &stars[star_count++], sizeof(int))) {
+            return -1;
+        }
+        if (spec.precision_star && !get_bytes(&cursor, &stars[star_count++], sizeof(int))) {
+            return -1;
+        }
+
+        // Output position; once the buffer is full snprintf only counts
+        size_t pos = 0;
+        if (out_size > 0) {
+            pos = total < out_size - 1 ? total : out_size - 1;
+        }
+        char* dst = out_size > 0 ? out + pos : NULL;
+        size_t dst_size = out_size > 0 ? out_size - pos : 0;
+        bool is_unsigned = strchr("uoxX", spec.conversion) != NULL;
+        int written = 0;
+
+        switch (spec.arg_class) {
+            case ARG_INT:
+                if (is_unsigned) READ_AND_RENDER(unsigned int); else READ_AND_RENDER(int);
+                break;
+            case ARG_LONG:
+                if (is_unsigned) READ_AND_RENDER(unsigned long); else READ_AND_RENDER(long);
+                break;
+            case ARG_LONG_LONG:
+                if (is_unsigned) READ_AND_RENDER(unsigned long long); else READ_AND_RENDER(long long);
+                break;
+            case ARG_INTMAX:
+                if (is_unsigned) READ_AND_RENDER(uintmax_t); else READ_AND_RENDER(intmax_t);
+                break;
+            case ARG_SIZE:        READ_AND_RENDER(size_t); break;
+            case ARG_PTRDIFF:     READ_AND_RENDER(ptrdiff_t); break;
+            case ARG_DOUBLE:      READ_AND_RENDER(double); break;
+            case ARG_LONG_DOUBLE: READ_AND_RENDER(long double); break;
+            case ARG_POINTER:     READ_AND_RENDER(void*); break;
+            case ARG_STRING: {
+                uint8_t present = 0;
+                if (!get_bytes(&cursor, &present, sizeof(present))) {
+                    return -1;
+                }
+                const char* str = NULL;
+                if (present) {
+                    str = (const char*)(cursor.data + cursor.used);
+                    size_t len = strnlen(str, cursor.size - cursor.used);
+                    if (len == cursor.size - cursor.used) {
+                        return -1;  // Missing terminator
+                    }
+                    cursor.used += len + 1;
+                }
+                written = RENDER_VALUE(str);
+                break;
+            }
+            default:
+                return -1;
+        }
+
+        if (written < 0) {
+            return -1;
+        }
+        total += (size_t)written;
+    }
+
+    return (int)total;
+}
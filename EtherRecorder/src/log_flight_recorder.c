@@ -0,0 +1,181 @@
+/**
+ * @file log_flight_recorder.c
+ * @brief Crash-surviving record of the most recent log entries.
+ *
+ * An entry's index, already unique and taken in logging order, picks its
+ * slot, so recording adds no shared counter of its own for writers to
+ * contend on. The slot's sequence is cleared while it is written and set
+ * last, so a slot caught half written by a crash is recognisably
+ * incomplete rather than wrong.
+ */
+
+#include "log_flight_recorder.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "logger.h"
+#include "log_deferred.h"
+#include "platform_file.h"
+#include "platform_path.h"
+#include "platform_string.h"
+#include "platform_time.h"
+
+#define FLIGHT_RECORDER_PAGE 0x1000  // Tables and slots start on page boundaries
+
+static PlatformMappedFileHandle g_recorder_file = NULL;
+// Set once the file is laid out, before any thread other than main logs
+static FlightRecorderHeader* g_recorder = NULL;
+static char (*g_recorder_labels)[FLIGHT_RECORDER_LABEL_SIZE] = NULL;
+static FlightRecorderFormat* g_recorder_formats = NULL;
+static FlightRecorderRecord* g_recorder_slots = NULL;
+
+static uint64_t round_up_to_page(uint64_t offset) {
+    return (offset + FLIGHT_RECORDER_PAGE - 1) & ~(uint64_t)(FLIGHT_RECORDER_PAGE - 1);
+}
+
+bool log_flight_recorder_open(const char* file_name, uint64_t size) {
+    uint64_t frequency = 0;
+    if (g_recorder || !file_name || !file_name[0] ||
+        platform_get_timestamp_frequency(&frequency) != PLATFORM_ERROR_SUCCESS) {
+        return false;
+    }
+
+    uint64_t labels_offset = round_up_to_page(sizeof(FlightRecorderHeader));
+    uint64_t formats_offset = round_up_to_page(labels_offset +
+        (uint64_t)FLIGHT_RECORDER_LABEL_COUNT * FLIGHT_RECORDER_LABEL_SIZE);
+    uint64_t slots_offset = round_up_to_page(formats_offset +
+        (uint64_t)FLIGHT_RECORDER_FORMAT_COUNT * sizeof(FlightRecorderFormat));
+    if (size < FLIGHT_RECORDER_MIN_SIZE) {
+        size = FLIGHT_RECORDER_MIN_SIZE;
+    }
+
+    // Keep what the previous run left, it may be all there is of a crash
+    char previous[MAX_PATH_LEN];
+    snprintf(previous, sizeof(previous), "%s.prev", file_name);
+    remove(previous);
+    rename(file_name, previous);
+
+    PlatformErrorCode error = PLATFORM_ERROR_SUCCESS;
+    g_recorder_file = platform_mapped_file_open(file_name, (size_t)size, true, &error);
+    if (!g_recorder_file) {
+        return false;
+    }
+
+    uint8_t* base = platform_mapped_file_data(g_recorder_file);
+    FlightRecorderHeader* header = (FlightRecorderHeader*)base;
+    memset(base, 0, (size_t)slots_offset);
+    header->version = FLIGHT_RECORDER_VERSION;
+    header->slot_size = FLIGHT_RECORDER_SLOT_SIZE;
+    header->slot_count = (uint32_t)((size - slots_offset) / FLIGHT_RECORDER_SLOT_SIZE);
+    header->format_count = FLIGHT_RECORDER_FORMAT_COUNT;
+    header->labels_offset = labels_offset;
+    header->formats_offset = formats_offset;
+    header->slots_offset = slots_offset;
+
+    PlatformHighResTimestamp_T reference;
+    time_t seconds = 0;
+    int64_t nanoseconds = 0;
+    platform_get_high_res_timestamp(&reference);
+    platform_timestamp_to_calendar_time(&reference, &seconds, &nanoseconds);
+    header->reference_counter = reference.counter;
+    header->reference_seconds = (int64_t)seconds;
+    header->reference_nanoseconds = nanoseconds;
+    header->counter_frequency = frequency;
+    platform_atomic_init_uint32(&header->closed, 0);
+    memcpy(header->magic, FLIGHT_RECORDER_MAGIC, sizeof(header->magic));
+
+    g_recorder_labels = (char (*)[FLIGHT_RECORDER_LABEL_SIZE])(base + labels_offset);
+    g_recorder_formats = (FlightRecorderFormat*)(base + formats_offset);
+    g_recorder_slots = (FlightRecorderRecord*)(base + slots_offset);
+    g_recorder = header;
+    return true;
+}
+
+/**
+ * @brief Finds or adds a format string in the format table.
+ * @return Its id, or FLIGHT_RECORDER_TEXT if it is too long or the table is full.
+ */
+static uint16_t intern_format(const char* format) {
+    size_t length = strlen(format);
+    if (length >= sizeof(g_recorder_formats[0].text)) {
+        return FLIGHT_RECORDER_TEXT;
+    }
+
+    // Format strings are literals, so their address identifies them
+    uint64_t key = (uint64_t)(uintptr_t)format;
+    uint32_t slot = (uint32_t)((key >> 3) * 0x9E3779B97F4A7C15ull >> 32) & (FLIGHT_RECORDER_FORMAT_COUNT - 1);
+    for (uint32_t probe = 0; probe < FLIGHT_RECORDER_FORMAT_COUNT; probe++) {
+        FlightRecorderFormat* entry = &g_recorder_formats[slot];
+        uint64_t current = platform_atomic_load_uint64(&entry->key);
+        if (current == 0) {
+            uint64_t expected = 0;
+            if (platform_atomic_compare_exchange_uint64(&entry->key, &expected, key)) {
+                memcpy(entry->text, format, length + 1);
+                platform_atomic_store_uint32(&entry->ready, 1);
+                return (uint16_t)slot;
+            }
+            current = expected;
+        }
+        if (current == key) {
+            return (uint16_t)slot;
+        }
+        slot = (slot + 1) & (FLIGHT_RECORDER_FORMAT_COUNT - 1);
+    }
+    return FLIGHT_RECORDER_TEXT;
+}
+
+void log_flight_recorder_record(const LogEntry_T* entry) {
+    FlightRecorderHeader* header = g_recorder;
+    if (!header || !entry) {
+        return;
+    }
+
+    FlightRecorderRecord* record = &g_recorder_slots[entry->index % header->slot_count];
+    platform_atomic_store_uint64(&record->sequence, 0);
+
+    record->index = entry->index;
+    record->timestamp = entry->timestamp.counter;
+    record->label_id = entry->label_id;
+    record->level = (uint16_t)entry->level;
+    record->format_id = FLIGHT_RECORDER_TEXT;
+    if (entry->format && entry->args_size <= sizeof(record->payload)) {
+        record->format_id = intern_format(entry->format);
+    }
+
+    if (record->format_id != FLIGHT_RECORDER_TEXT) {
+        memcpy(record->payload, entry->message, entry->args_size);
+        record->payload_size = entry->args_size;
+    } else {
+        // Arguments that do not fit are rendered, cut to the slot; rare enough to pay for here
+        char text[LOG_MSG_BUFFER_SIZE];
+        const char* message = entry->message;
+        if (entry->format) {
+            if (log_deferred_render(text, sizeof(text), entry->format,
+                                    (const uint8_t*)entry->message, entry->args_size) < 0) {
+                text[0] = '\0';
+            }
+            message = text;
+        }
+        size_t length = strnlen(message, sizeof(record->payload));
+        memcpy(record->payload, message, length);
+        record->payload_size = (uint16_t)length;
+    }
+
+    platform_atomic_store_uint64(&record->sequence, entry->index);
+}
+
+void log_flight_recorder_label(uint16_t label_id, const char* label) {
+    if (!g_recorder || label_id >= FLIGHT_RECORDER_LABEL_COUNT || !label) {
+        return;
+    }
+    g_recorder_labels[label_id][0] = '\0';
+    platform_strcat(g_recorder_labels[label_id], label, FLIGHT_RECORDER_LABEL_SIZE);
+}
+
+void log_flight_recorder_mark_closed(void) {
+    if (g_recorder) {
+        platform_atomic_store_uint32(&g_recorder->closed, 1);
+    }
+}
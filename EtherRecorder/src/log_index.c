@@ -0,0 +1,97 @@
+/**
+ * @file log_index.c
+ * @brief Sparse side index of a log file, for seeking by entry index or time.
+ */
+
+#include "log_index.h"
+
+#include <string.h>
+
+#include "platform_path.h"
+
+#define LOG_INDEX_MAGIC "ERIX"
+#define LOG_INDEX_VERSION 1
+#define LOG_INDEX_HEADER_SIZE 16
+#define LOG_INDEX_POINT_SIZE 24
+
+static void put_u32(uint8_t* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static void put_u64(uint8_t* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+static uint64_t get_u64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+void log_index_path(char* path, size_t size, const char* log_file_name) {
+    snprintf(path, size, "%s%s", log_file_name, LOG_INDEX_EXTENSION);
+}
+
+FILE* log_index_open(const char* log_file_name, bool truncate, uint32_t interval) {
+    char path[MAX_PATH_LEN];
+    log_index_path(path, sizeof(path), log_file_name);
+
+    FILE* index = fopen(path, truncate ? "wb" : "ab");
+    if (!index) {
+        return NULL;
+    }
+    if (fseek(index, 0, SEEK_END) == 0 && ftell(index) == 0) {
+        uint8_t header[LOG_INDEX_HEADER_SIZE];
+        memcpy(header, LOG_INDEX_MAGIC, 4);
+        put_u32(header + 4, LOG_INDEX_VERSION);
+        put_u32(header + 8, interval);
+        put_u32(header + 12, 0);
+        if (fwrite(header, 1, sizeof(header), index) != sizeof(header)) {
+            fclose(index);
+            return NULL;
+        }
+    }
+    return index;
+}
+
+bool log_index_write_point(FILE* index, const LogIndexPoint* point) {
+    uint8_t record[LOG_INDEX_POINT_SIZE];
+    put_u64(record, point->index);
+    put_u64(record + 8, (uint64_t)point->time);
+    put_u64(record + 16, point->offset);
+    return fwrite(record, 1, sizeof(record), index) == sizeof(record);
+}
+
+bool log_index_find_start(const char* log_file_name, uint64_t first_index, int64_t from, uint64_t* offset) {
+    char path[MAX_PATH_LEN];
+    log_index_path(path, sizeof(path), log_file_name);
+    *offset = 0;
+
+    FILE* index = fopen(path, "rb");
+    if (!index) {
+        return false;
+    }
+
+    uint8_t header[LOG_INDEX_HEADER_SIZE];
+    bool valid = fread(header, 1, sizeof(header), index) == sizeof(header) &&
+                 memcmp(header, LOG_INDEX_MAGIC, 4) == 0 &&
+                 get_u32(header + 4) == LOG_INDEX_VERSION;
+
+    // Lines before a point are unwanted if they are below the first index or before the
+    // earliest time. Points are in index order, so the scan stops at the first one that is neither.
+    uint8_t record[LOG_INDEX_POINT_SIZE];
+    while (valid && fread(record, 1, sizeof(record), index) == sizeof(record)) {
+        if (get_u64(record) > first_index && (int64_t)get_u64(record + 8) >= from) {
+            break;
+        }
+        *offset = get_u64(record + 16);
+    }
+    fclose(index);
+    return valid;
+}
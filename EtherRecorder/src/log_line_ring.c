@@ -0,0 +1,118 @@
+/**
+ * @file log_line_ring.c
+ * @brief Bounded, lossy ring of formatted log lines between the logger and a sink thread.
+ */
+
+#include "log_line_ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform_sync.h"
+
+#define LOG_LINE_RING_MAX_SIZE 0x40000000u
+#define LOG_LINE_RECORD_HEADER 2  // Each line is held after its 16-bit length
+
+static void ring_write(LogLineRing* ring, uint32_t position, const void* data, uint32_t length) {
+    uint32_t offset = position & (ring->size - 1);
+    uint32_t first = (length < ring->size - offset) ? length : ring->size - offset;
+    memcpy(ring->data + offset, data, first);
+    memcpy(ring->data, (const uint8_t*)data + first, length - first);
+}
+
+static void ring_read(const LogLineRing* ring, uint32_t position, void* data, uint32_t length) {
+    uint32_t offset = position & (ring->size - 1);
+    uint32_t first = (length < ring->size - offset) ? length : ring->size - offset;
+    memcpy(data, ring->data + offset, first);
+    memcpy((uint8_t*)data + first, ring->data, length - first);
+}
+
+bool log_line_ring_init(LogLineRing* ring, uint32_t requested_size) {
+    uint32_t size = LOG_LINE_RING_MIN_SIZE;
+    while (size < requested_size && size < LOG_LINE_RING_MAX_SIZE) {
+        size <<= 1;
+    }
+    ring->data = malloc(size);
+    if (!ring->data) {
+        return false;
+    }
+    ring->size = size;
+    platform_atomic_init_uint32(&ring->head, 0);
+    platform_atomic_init_uint32(&ring->tail, 0);
+    platform_atomic_init_uint32(&ring->consumer_parked, 0);
+    platform_atomic_init_uint64(&ring->dropped, 0);
+    return true;
+}
+
+void log_line_ring_free(LogLineRing* ring) {
+    free(ring->data);
+    ring->data = NULL;
+    ring->size = 0;
+}
+
+bool log_line_ring_push(LogLineRing* ring, const char* line, size_t length) {
+    if (!ring->data || length == 0 || length > UINT16_MAX) {
+        return false;
+    }
+
+    // Only the producer writes head; the tail moves as the consumer takes lines
+    uint32_t head = platform_atomic_load_uint32(&ring->head);
+    uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+    uint32_t needed = LOG_LINE_RECORD_HEADER + (uint32_t)length;
+    if (ring->size - (head - tail) < needed) {
+        platform_atomic_fetch_add_uint64(&ring->dropped, 1);
+        return false;
+    }
+
+    uint16_t record_length = (uint16_t)length;
+    ring_write(ring, head, &record_length, LOG_LINE_RECORD_HEADER);
+    ring_write(ring, head + LOG_LINE_RECORD_HEADER, line, (uint32_t)length);
+    platform_atomic_store_uint32(&ring->head, head + needed);
+
+    // The consumer may have drained the ring and parked since tail was loaded, so every push checks
+    if (platform_atomic_load_uint32(&ring->consumer_parked) &&
+        platform_atomic_exchange_uint32(&ring->consumer_parked, 0)) {
+        platform_wake_by_address_single(&ring->consumer_parked);
+    }
+    return true;
+}
+
+size_t log_line_ring_peek(LogLineRing* ring, char* buffer, size_t capacity, uint32_t* next_tail) {
+    uint32_t head = platform_atomic_load_uint32(&ring->head);
+    uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+    size_t used = 0;
+
+    while (tail != head) {
+        uint16_t length;
+        ring_read(ring, tail, &length, LOG_LINE_RECORD_HEADER);
+        if (length > capacity) {
+            tail += LOG_LINE_RECORD_HEADER + length;  // Can never be written whole; skip it
+            continue;
+        }
+        if (used + length > capacity) {
+            break;
+        }
+        ring_read(ring, tail + LOG_LINE_RECORD_HEADER, buffer + used, length);
+        used += length;
+        tail += LOG_LINE_RECORD_HEADER + length;
+    }
+    *next_tail = tail;
+    return used;
+}
+
+void log_line_ring_consume(LogLineRing* ring, uint32_t next_tail) {
+    platform_atomic_store_uint32(&ring->tail, next_tail);
+}
+
+void log_line_ring_wait(LogLineRing* ring, uint32_t timeout_ms) {
+    platform_atomic_store_uint32(&ring->consumer_parked, 1);
+    // Re-check after announcing: a line pushed before the flag was seen is visible here
+    if (platform_atomic_load_uint32(&ring->head) == platform_atomic_load_uint32(&ring->tail)) {
+        platform_wait_on_address(&ring->consumer_parked, 1, timeout_ms);
+    }
+    platform_atomic_store_uint32(&ring->consumer_parked, 0);
+}
+
+uint64_t log_line_ring_dropped(const LogLineRing* ring) {
+    return platform_atomic_load_uint64(&ring->dropped);
+}
@@ -0,0 +1,296 @@
+/**
+ * @file log_maintenance.c
+ * @brief Background housekeeping of rotated log files.
+ */
+
+#include "log_maintenance.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform_path.h"
+#include "platform_threads.h"
+#include "platform_string.h"
+
+#include "app_config.h"
+#include "log_archive.h"
+#include "log_index.h"
+#include "logger.h"
+#include "message_pool.h"
+#include "message_queue_types.h"
+#include "thread_registry.h"
+#include "utils.h"
+
+#define LOG_MAINTENANCE_POLL_MS 250   // How often the queue is checked for work
+#define ROTATION_STAMP_LENGTH 16      // ".YYYYMMDD_HHMMSS" as written by the logger
+
+extern const ThreadConfig ThreadConfigTemplate;
+
+static int g_log_retention_count = 0;  // Rotated files kept per log, 0 keeps all
+static bool g_log_compress_rotated = false;  // Replace rotated files with seekable archives
+
+// Rotated siblings of one log file found in its directory
+typedef struct RotatedLogList {
+    const char* stem;          // File name up to its extension
+    size_t stem_length;
+    const char* extension;     // Extension including the dot, or ""
+    size_t extension_length;
+    char** names;
+    size_t count;
+    size_t capacity;
+} RotatedLogList;
+
+static bool is_rotation_stamp(const char* text) {
+    if (text[0] != '.') {
+        return false;
+    }
+    for (int i = 1; i < ROTATION_STAMP_LENGTH; i++) {
+        if (i == 9) {
+            if (text[i] != '_') return false;
+        } else if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Collects directory entries named <stem>.YYYYMMDD_HHMMSS<extension>[.suffix].
+ */
+static bool collect_rotated_log(const char* name, void* context) {
+    RotatedLogList* list = (RotatedLogList*)context;
+
+    if (strncmp(name, list->stem, list->stem_length) != 0 ||
+        strlen(name) < list->stem_length + ROTATION_STAMP_LENGTH ||
+        !is_rotation_stamp(name + list->stem_length)) {
+        return true;
+    }
+
+    // Anything after the extension is a further encoding of the same rotation, e.g. compression
+    const char* rest = name + list->stem_length + ROTATION_STAMP_LENGTH;
+    if (strncmp(rest, list->extension, list->extension_length) != 0) {
+        return true;
+    }
+    rest += list->extension_length;
+    if (*rest != '\0' && *rest != '.') {
+        return true;
+    }
+    // A rotation's index is kept or removed along with it, rather than counted as a rotation
+    if (strcmp(rest, LOG_INDEX_EXTENSION) == 0) {
+        return true;
+    }
+
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 16;
+        char** names = realloc(list->names, capacity * sizeof(*names));
+        if (!names) {
+            return false;
+        }
+        list->names = names;
+        list->capacity = capacity;
+    }
+
+    size_t length = strlen(name) + 1;
+    char* copy = malloc(length);
+    if (!copy) {
+        return false;
+    }
+    memcpy(copy, name, length);
+    list->names[list->count++] = copy;
+    return true;
+}
+
+static int compare_names(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/**
+ * @brief Builds the path of a file in a directory, which may be "" for the current one.
+ */
+static void join_path(char* path, size_t size, const char* directory, const char* name) {
+    if (directory[0]) {
+        snprintf(path, size, "%s%c%s", directory, PATH_SEPARATOR, name);
+    } else {
+        snprintf(path, size, "%s", name);
+    }
+}
+
+/**
+ * @brief Removes the index of a rotated log file, if it has one.
+ */
+static void remove_log_index(const char* path) {
+    char index_path[MAX_PATH_LEN];
+    log_index_path(index_path, sizeof(index_path), path);
+    remove(index_path);
+}
+
+/**
+ * @brief Replaces a rotated log file with a compressed archive of it.
+ *
+ * The archive has a time index of its own, and the offsets in the file's
+ * index mean nothing in it, so that index is removed too.
+ * @param directory Directory holding the file.
+ * @param name In: name of the rotated file. Out: name of the archive, on success.
+ */
+static void compress_rotated_log(const char* directory, char** name) {
+    char source_path[MAX_PATH_LEN];
+    char archive_path[MAX_PATH_LEN];
+    join_path(source_path, sizeof(source_path), directory, *name);
+    join_path(archive_path, sizeof(archive_path), directory, *name);
+    platform_strcat(archive_path, LOG_ARCHIVE_EXTENSION, sizeof(archive_path));
+
+    if (!log_archive_compress(source_path, archive_path)) {
+        logger_log(LOG_WARN, "Failed to compress rotated log file %s", source_path);
+        return;
+    }
+    if (remove(source_path) != 0) {
+        logger_log(LOG_WARN, "Compressed %s but failed to remove it", source_path);
+        return;
+    }
+    remove_log_index(source_path);
+    logger_log(LOG_DEBUG, "Compressed rotated log file %s", source_path);
+
+    size_t length = strlen(*name) + sizeof(LOG_ARCHIVE_EXTENSION);
+    char* archive_name = malloc(length);
+    if (archive_name) {
+        snprintf(archive_name, length, "%s%s", *name, LOG_ARCHIVE_EXTENSION);
+        free(*name);
+        *name = archive_name;
+    }
+}
+
+/**
+ * @brief Compresses the rotations of a log file, then deletes the oldest beyond the retention count.
+ * @param log_file_name Path of the live log file.
+ */
+static void maintain_rotated_logs(const char* log_file_name) {
+    if (g_log_retention_count <= 0 && !g_log_compress_rotated) {
+        return;
+    }
+
+    char directory[MAX_PATH_LEN];
+    strip_directory_path(log_file_name, directory, sizeof(directory));
+    const char* file_name = log_file_name + strlen(directory);
+    if (*file_name == PATH_SEPARATOR) {
+        file_name++;
+    }
+
+    const char* last_dot = strrchr(file_name, '.');
+    RotatedLogList list = {0};
+    list.stem = file_name;
+    list.stem_length = last_dot ? (size_t)(last_dot - file_name) : strlen(file_name);
+    list.extension = last_dot ? last_dot : "";
+    list.extension_length = strlen(list.extension);
+
+    PlatformErrorCode result = platform_list_directory(directory[0] ? directory : ".",
+                                                       collect_rotated_log, &list);
+    if (result != PLATFORM_ERROR_SUCCESS) {
+        logger_log(LOG_WARN, "Log maintenance could not list directory for %s", log_file_name);
+    }
+
+    // Names differ only in their timestamp, so name order is age order
+    qsort(list.names, list.count, sizeof(*list.names), compare_names);
+
+    // Plain rotations, including any left by an earlier run, are compressed oldest first
+    size_t plain_length = list.stem_length + ROTATION_STAMP_LENGTH + list.extension_length;
+    for (size_t i = 0; g_log_compress_rotated && i < list.count && !shutdown_signalled(); i++) {
+        if (strlen(list.names[i]) == plain_length) {
+            compress_rotated_log(directory, &list.names[i]);
+        }
+    }
+
+    if (g_log_retention_count > 0 && list.count > (size_t)g_log_retention_count) {
+        size_t excess = list.count - (size_t)g_log_retention_count;
+        for (size_t i = 0; i < excess; i++) {
+            char path[MAX_PATH_LEN];
+            join_path(path, sizeof(path), directory, list.names[i]);
+            if (remove(path) == 0) {
+                remove_log_index(path);
+                logger_log(LOG_DEBUG, "Removed rotated log file %s", path);
+            } else {
+                logger_log(LOG_WARN, "Failed to remove rotated log file %s", path);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < list.count; i++) {
+        free(list.names[i]);
+    }
+    free(list.names);
+}
+
+bool log_maintenance_request(const char* log_file_name) {
+    if (!log_file_name) {
+        return false;
+    }
+
+    size_t length = strlen(log_file_name) + 1;
+    Message_T* message = message_alloc(MSG_TYPE_LOG_ROTATED, length);
+    if (!message) {
+        return false;
+    }
+    message->header.content_size = length;
+    memcpy(message->content, log_file_name, length);
+
+    if (push_message(LOG_MAINTENANCE_THREAD_LABEL, message, 0) != THREAD_REG_SUCCESS) {
+        message_release(message);
+        return false;
+    }
+    return true;
+}
+
+static ThreadResult process_maintenance_message(ThreadConfig* thread, const Message_T* message) {
+    (void)thread;
+
+    if (message->header.type == MSG_TYPE_LOG_ROTATED &&
+        message->header.content_size > 0 &&
+        message->header.content_size <= message->header.capacity &&
+        message->content[message->header.content_size - 1] == '\0') {
+        maintain_rotated_logs((const char*)message->content);
+    }
+    return THREAD_SUCCESS;
+}
+
+static void* log_maintenance_init(void* arg) {
+    (void)arg;
+
+    // Housekeeping must never compete with the threads it serves
+    platform_thread_set_priority(platform_thread_get_handle(), PLATFORM_THREAD_PRIORITY_LOWEST);
+    g_log_retention_count = get_config_int("logger", "log_retention_count", g_log_retention_count);
+    g_log_compress_rotated = get_config_bool("logger", "log_compress_rotated", g_log_compress_rotated);
+    return (void*)THREAD_SUCCESS;
+}
+
+static void* log_maintenance_function(void* arg) {
+    ThreadConfig* thread_info = (ThreadConfig*)arg;
+
+    logger_log(LOG_INFO, "Log maintenance thread started, keeping %d rotated files per log%s",
+               g_log_retention_count, g_log_compress_rotated ? ", compressed" : "");
+
+    while (!shutdown_signalled()) {
+        ThreadResult result = service_thread_queue(thread_info);
+        if (result != THREAD_SUCCESS) {
+            return (void*)(uintptr_t)(result);
+        }
+        sleep_ms(LOG_MAINTENANCE_POLL_MS);
+    }
+
+    logger_log(LOG_INFO, "Log maintenance thread shutting down");
+    return (void*)THREAD_SUCCESS;
+}
+
+ThreadConfig* get_log_maintenance_thread(void) {
+    static ThreadConfig log_maintenance_thread;
+    static bool initialized = false;
+
+    if (!initialized) {
+        log_maintenance_thread = ThreadConfigTemplate;
+        log_maintenance_thread.label = LOG_MAINTENANCE_THREAD_LABEL;
+        log_maintenance_thread.func = log_maintenance_function;
+        log_maintenance_thread.init_func = log_maintenance_init;
+        log_maintenance_thread.msg_processor = process_maintenance_message;
+        initialized = true;
+    }
+    return &log_maintenance_thread;
+}
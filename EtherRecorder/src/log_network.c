@@ -0,0 +1,213 @@
+/**
+ * @file log_network.c
+ * @brief Network log sink, streaming log lines to a remote collector over UDP or TCP.
+ */
+
+#include "log_network.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "platform_sockets.h"
+#include "platform_string.h"
+#include "platform_threads.h"
+
+#include "app_config.h"
+#include "log_line_ring.h"
+#include "logger.h"
+#include "utils.h"
+
+#define LOG_NETWORK_DEFAULT_PORT 7020
+#define LOG_NETWORK_DEFAULT_BUFFER 0x100000     // Default ring (1 MB)
+#define LOG_NETWORK_RETRY_MIN_MS 500            // First reconnect delay, doubled on each failure
+#define LOG_NETWORK_RETRY_MAX_MS 10000
+#define LOG_NETWORK_CONNECT_TIMEOUT_MS 1000
+#define LOG_NETWORK_SEND_TIMEOUT_MS 1000
+#define LOG_NETWORK_PARK_MS 100                 // Longest wait for lines, so a shutdown is still noticed
+#define LOG_NETWORK_PROBE_MS 50                 // Time allowed for a refused UDP send to be reported back
+
+extern const ThreadConfig ThreadConfigTemplate;
+
+static LogLineRing g_ring;                      // Lines waiting for the collector, no data if the sink is off
+static PlatformSocketAddress g_collector;
+static bool g_use_tcp = false;
+
+bool log_network_init(void) {
+    if (g_ring.data) {
+        return true;
+    }
+
+    const char* host = get_config_string("logger", "log_host", "127.0.0.1");
+    const char* protocol = get_config_string("logger", "log_protocol", "UDP");
+    int port = get_config_int("logger", "log_port", LOG_NETWORK_DEFAULT_PORT);
+    int buffer_size = get_config_int("logger", "log_network_buffer_size", LOG_NETWORK_DEFAULT_BUFFER);
+
+    if (port <= 0 || port > UINT16_MAX) {
+        return false;
+    }
+    memset(&g_collector, 0, sizeof(g_collector));
+    platform_strcat(g_collector.host, host, sizeof(g_collector.host));
+    g_collector.port = (uint16_t)port;
+    g_use_tcp = strcmp_nocase(protocol, "TCP") == 0;
+
+    return log_line_ring_init(&g_ring, buffer_size > 0 ? (uint32_t)buffer_size : 0);
+}
+
+bool log_network_enqueue(const char* line, size_t length) {
+    return log_line_ring_push(&g_ring, line, length);
+}
+
+static PlatformSocketHandle connect_collector(void) {
+    PlatformSocketOptions options = {
+        .blocking = true,
+        .send_timeout_ms = LOG_NETWORK_SEND_TIMEOUT_MS,
+        .connect_timeout_ms = LOG_NETWORK_CONNECT_TIMEOUT_MS,
+        .keep_alive = g_use_tcp,
+    };
+    PlatformSocketHandle socket = NULL;
+
+    if (platform_socket_create(&socket, g_use_tcp, &options) != PLATFORM_ERROR_SUCCESS) {
+        return NULL;
+    }
+    if (platform_socket_connect(socket, &g_collector) != PLATFORM_ERROR_SUCCESS) {
+        platform_socket_close(socket);
+        return NULL;
+    }
+    return socket;
+}
+
+static bool send_all(PlatformSocketHandle socket, const char* data, size_t length) {
+    while (length > 0) {
+        size_t sent = 0;
+        if (platform_socket_send(socket, data, length, &sent) != PLATFORM_ERROR_SUCCESS || sent == 0) {
+            return false;
+        }
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+/**
+ * @brief Tells whether lines just sent over UDP were refused.
+ *
+ * A UDP send into the void succeeds; the refusal comes back afterwards, as an
+ * error the connected socket reports on its next receive.
+ */
+static bool collector_refused(PlatformSocketHandle socket) {
+    if (platform_socket_wait_readable(socket, LOG_NETWORK_PROBE_MS) != PLATFORM_ERROR_SUCCESS) {
+        return false;  // Nothing came back in time
+    }
+    char reply[64];
+    size_t received = 0;
+    return platform_socket_receive(socket, reply, sizeof(reply), &received) != PLATFORM_ERROR_SUCCESS;
+}
+
+/**
+ * @brief Sleeps before the next connection attempt, waking early on shutdown.
+ */
+static void wait_to_reconnect(uint32_t delay_ms) {
+    for (uint32_t waited = 0; waited < delay_ms && !shutdown_signalled(); waited += LOG_NETWORK_PARK_MS) {
+        sleep_ms(LOG_NETWORK_PARK_MS);
+    }
+}
+
+static void* log_network_function(void* arg) {
+    (void)arg;
+
+    // The thread is always started, but only has work with "network" in log_destination
+    if (!g_ring.data) {
+        return (void*)THREAD_SUCCESS;
+    }
+
+    static char buffer[LOG_NETWORK_WRITE_SIZE];
+    size_t capacity = g_use_tcp ? LOG_NETWORK_WRITE_SIZE : LOG_NETWORK_DATAGRAM_SIZE;
+    const char* protocol = g_use_tcp ? "TCP" : "UDP";
+    PlatformSocketHandle socket = NULL;
+    uint32_t retry_ms = LOG_NETWORK_RETRY_MIN_MS;
+    bool reachable = false;      // Not until lines have gone out; UDP cannot tell before
+    bool down_reported = false;  // Only changes of state are logged
+    uint64_t dropped_reported = 0;
+
+    logger_log(LOG_INFO, "Log network sink started, sending to %s:%u over %s",
+               g_collector.host, g_collector.port, protocol);
+
+    while (!shutdown_signalled()) {
+        if (!socket) {
+            socket = connect_collector();
+        }
+
+        uint32_t next_tail;
+        size_t length = 0;
+        if (socket) {
+            length = log_line_ring_peek(&g_ring, buffer, capacity, &next_tail);
+            if (length == 0) {
+                log_line_ring_consume(&g_ring, next_tail);  // Past any line too long to send
+                log_line_ring_wait(&g_ring, LOG_NETWORK_PARK_MS);
+                continue;
+            }
+        }
+
+        // Unsent lines stay in the ring and go out again once the collector is back. Until UDP
+        // lines are known to arrive, each send is checked for a refusal before it counts.
+        if (!socket || !send_all(socket, buffer, length) ||
+            (!g_use_tcp && !reachable && collector_refused(socket))) {
+            if (socket) {
+                platform_socket_close(socket);
+                socket = NULL;
+            }
+            if (!down_reported) {
+                logger_log(LOG_WARN, "Log collector %s:%u unreachable, buffering log lines",
+                           g_collector.host, g_collector.port);
+                down_reported = true;
+            }
+            reachable = false;
+            wait_to_reconnect(retry_ms);
+            retry_ms = (retry_ms * 2 < LOG_NETWORK_RETRY_MAX_MS) ? retry_ms * 2 : LOG_NETWORK_RETRY_MAX_MS;
+            continue;
+        }
+
+        if (!reachable) {
+            logger_log(LOG_INFO, "Log collector %s:%u reachable", g_collector.host, g_collector.port);
+            reachable = true;
+            down_reported = false;
+            retry_ms = LOG_NETWORK_RETRY_MIN_MS;
+        }
+        log_line_ring_consume(&g_ring, next_tail);
+
+        uint64_t dropped = log_line_ring_dropped(&g_ring);
+        if (dropped != dropped_reported) {
+            logger_log(LOG_WARN, "%llu log lines dropped, the network log buffer was full",
+                       (unsigned long long)(dropped - dropped_reported));
+            dropped_reported = dropped;
+        }
+    }
+
+    // Send what is already waiting, without retrying
+    if (socket) {
+        uint32_t next_tail;
+        size_t length;
+        while ((length = log_line_ring_peek(&g_ring, buffer, capacity, &next_tail)) > 0 &&
+               send_all(socket, buffer, length)) {
+            log_line_ring_consume(&g_ring, next_tail);
+        }
+        platform_socket_close(socket);
+    }
+
+    logger_log(LOG_INFO, "Log network sink shutting down");
+    return (void*)THREAD_SUCCESS;
+}
+
+ThreadConfig* get_log_network_thread(void) {
+    static ThreadConfig log_network_thread;
+    static bool initialized = false;
+
+    if (!initialized) {
+        log_network_thread = ThreadConfigTemplate;
+        log_network_thread.label = LOG_NETWORK_THREAD_LABEL;
+        log_network_thread.func = log_network_function;
+        initialized = true;
+    }
+    return &log_network_thread;
+}
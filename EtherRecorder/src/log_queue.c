@@ -3,255 +3,514 @@
 #include <string.h>  // Add this include for memset
 #include <stdbool.h>
 
-#include "platform_random.h"
-#include "platform_mutex.h"
 #include "platform_atomic.h"
+#include "platform_threads.h"
+#include "platform_sync.h"
+#include "platform_time.h"
 
 #include "logger.h"
+#include "logger_metrics.h"
 
-extern void log_immediately(const LogEntry_T* entry);
-
-extern PlatformMutex_T logging_mutex; // Mutex for thread safety
 LogQueue_T global_log_queue; // Define the log queue
 
 
-#define QUEUE_HIGH_WATERMARK 0.99  // 99% full
-#define QUEUE_LOW_WATERMARK 0.60   // 60% full
+#define LOG_RING_MASK (LOG_RING_BYTES - 1)
+#define LOG_RECORD_SIZE(payload) \
+    ((uint32_t)((sizeof(LogRecordHeader_T) + (payload) + LOG_RECORD_ALIGN - 1) & ~(size_t)(LOG_RECORD_ALIGN - 1)))
 
-bool console_logging_suspended = false;
+// The rings owned by the calling thread, one per worker, claimed on the first push for that worker
+static THREAD_LOCAL LogRing_T* thread_rings[LOG_MAX_WORKERS];
+static THREAD_LOCAL uint32_t thread_dropped = 0;       // Dropped since this thread's last queued entry
+static THREAD_LOCAL uint32_t thread_sample_count = 0;  // Entries offered while sampling
+static THREAD_LOCAL bool thread_is_consumer = false;
+static THREAD_LOCAL uint32_t thread_push_count = 0;    // Pushes made, to sample latency from
 
 /**
  * @copydoc log_queue_init
  */
 void log_queue_init(LogQueue_T *queue) {
-    queue->head.value = 0;
-    queue->tail.value = 0;
-    // Initialize all slot states to empty (0)
-    memset(queue->slot_states, 0, LOG_QUEUE_SIZE * sizeof(uint32_t));
+    for (int i = 0; i < LOG_RING_COUNT; i++) {
+        platform_atomic_init_uint32(&queue->rings[i].head, 0);
+        platform_atomic_init_uint32(&queue->rings[i].tail, 0);
+        platform_atomic_init_uint32(&queue->rings[i].state, LOG_RING_FREE);
+        platform_atomic_init_uint32(&queue->rings[i].worker, 0);
+        platform_atomic_init_uint32(&queue->rings[i].producer_parked, 0);
+    }
+    platform_atomic_init_uint32(&queue->ring_count, 0);
+    for (int i = 0; i < LOG_MAX_WORKERS; i++) {
+        platform_atomic_init_uint32(&queue->consumer_parked[i], 0);
+        platform_atomic_init_uint32(&queue->worker_running[i], i == 0);
+    }
+    platform_atomic_init_uint64(&queue->dropped_total, 0);
+    queue->overflow_policy = LOG_OVERFLOW_BLOCK;
+    queue->overflow_level = LOG_WARN;
+    queue->sample_rate = 10;
 }
 
-static double get_queue_capacity(const LogQueue_T* queue) {
-    uint32_t head = platform_atomic_load_uint32(&queue->head);
-    uint32_t tail = platform_atomic_load_uint32(&queue->tail);
-    
-    uint32_t used;
-    if (head >= tail) {
-        used = head - tail;
-    } else {
-        used = LOG_QUEUE_SIZE - (tail - head);
+/**
+ * @copydoc log_queue_set_overflow_policy
+ */
+void log_queue_set_overflow_policy(LogQueue_T *queue, LogOverflowPolicy policy,
+                                   LogLevel overflow_level, uint32_t sample_rate) {
+    queue->overflow_policy = policy;
+    queue->overflow_level = overflow_level;
+    queue->sample_rate = sample_rate ? sample_rate : 1;
+}
+
+/**
+ * @copydoc log_queue_set_consumer_thread
+ */
+void log_queue_set_consumer_thread(void) {
+    thread_is_consumer = true;
+}
+
+/**
+ * @copydoc log_queue_dropped_count
+ */
+uint64_t log_queue_dropped_count(const LogQueue_T *queue) {
+    return platform_atomic_load_uint64(&queue->dropped_total);
+}
+
+/**
+ * @brief Claims a free ring from the pool for the calling thread.
+ * @param worker The worker that will consume the ring.
+ * @return The claimed ring, or NULL if every ring is in use.
+ */
+static LogRing_T* claim_ring(LogQueue_T *queue, uint32_t worker) {
+    for (uint32_t i = 0; i < LOG_RING_COUNT; i++) {
+        LogRing_T* ring = &queue->rings[i];
+        uint32_t expected = LOG_RING_FREE;
+        if (platform_atomic_compare_exchange_uint32(&ring->state, &expected, LOG_RING_ACTIVE)) {
+            // Published by the first head store, so a worker that sees a record sees this too
+            platform_atomic_store_uint32(&ring->worker, worker);
+            // Make sure the logger scans up to and including this ring
+            uint32_t count = platform_atomic_load_uint32(&queue->ring_count);
+            while (count <= i &&
+                   !platform_atomic_compare_exchange_uint32(&queue->ring_count, &count, i + 1)) {
+            }
+            return ring;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @copydoc log_queue_set_worker_running
+ */
+void log_queue_set_worker_running(LogQueue_T *queue, uint32_t worker, bool running) {
+    if (worker > 0 && worker < LOG_MAX_WORKERS) {
+        platform_atomic_store_uint32(&queue->worker_running[worker], running ? 1 : 0);
     }
-    
-    return (double)used / LOG_QUEUE_SIZE;
 }
 
-static void handle_queue_capacity_state(double capacity) {
-    // If we hit high watermark, suspend console logging
-    if (capacity >= QUEUE_HIGH_WATERMARK && !console_logging_suspended) {
-        console_logging_suspended = true;
-        LogEntry_T warning;
-        create_log_entry(&warning, LOG_WARN, "Queue near capacity - suspending console output");
-        log_now(&warning);  // Direct log to avoid recursion
-        fflush(stdout);
-        fflush(stderr);
-        console_logging_suspended = true;
-        sleep_ms(100);
+/**
+ * @copydoc log_queue_worker_running
+ */
+bool log_queue_worker_running(const LogQueue_T *queue, uint32_t worker) {
+    return worker < LOG_MAX_WORKERS && platform_atomic_load_uint32(&queue->worker_running[worker]) != 0;
+}
+
+static void wake_consumer(LogQueue_T *log_queue, uint32_t worker) {
+    // Worker 0 drains the entries of a worker that is not running, so it is the one to wake
+    if (!platform_atomic_load_uint32(&log_queue->worker_running[worker])) {
+        worker = 0;
     }
-    // If we drop below low watermark, resume console logging
-    else if (capacity <= QUEUE_LOW_WATERMARK && console_logging_suspended) {
-        console_logging_suspended = false;
-        LogEntry_T info;
-        create_log_entry(&info, LOG_INFO, "Queue capacity normalized - resuming console output");
-        log_now(&info);  // Direct log to avoid recursion
+    PlatformAtomicUInt32* parked = &log_queue->consumer_parked[worker];
+    if (platform_atomic_load_uint32(parked) && platform_atomic_exchange_uint32(parked, 0)) {
+        platform_wake_by_address_single(parked);
     }
 }
 
 /**
- * Helper function for exponential backoff
+ * @brief Wakes a ring's owner if it is parked waiting for room, after the tail has moved.
  */
-static void backoff_delay(int attempt) {
-    if (attempt <= 0) return;
-    
-    // Exponential backoff with a cap
-    int delay = (1 << (attempt > 10 ? 10 : attempt)); // Cap at 2^10
-    
-    // Add some randomness to avoid thundering herd problem
-    delay = delay + (int)platform_random_range(0, delay);
-    
-    sleep_ms(delay);
+static void wake_producer(LogRing_T* ring) {
+    if (platform_atomic_load_uint32(&ring->producer_parked) &&
+        platform_atomic_exchange_uint32(&ring->producer_parked, 0)) {
+        platform_wake_by_address_single(&ring->producer_parked);
+    }
+}
+
+static LogPushResult drop_entries(LogQueue_T *log_queue, uint32_t count) {
+    thread_dropped += count;
+    platform_atomic_fetch_add_uint64(&log_queue->dropped_total, count);
+    return LOG_PUSH_DROPPED;
 }
 
 /**
- * @copydoc log_queue_push
+ * @brief Waits for the worker to free at least needed bytes of one of the calling thread's rings.
+ * @return true once there is room, false if LOG_OVERFLOW_BLOCK_TIMEOUT_MS passed first.
  */
-bool log_queue_push(LogQueue_T *log_queue, const LogEntry_T *entry) {
-    if (!entry || entry->thread_label[0] == '\0') {
-        return false;
+static bool wait_for_room(LogQueue_T *log_queue, uint32_t worker, uint32_t head, uint32_t needed) {
+    LogRing_T* ring = thread_rings[worker];
+    uint32_t start = 0;
+    platform_get_tick_count(&start);
+    uint32_t now = start;
+
+    do {
+        wake_consumer(log_queue, worker);
+
+        // Announce before re-checking: a tail moved after this store finds the flag and wakes us
+        platform_atomic_store_uint32(&ring->producer_parked, 1);
+        uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+        if (LOG_RING_BYTES - (head - tail) >= needed) {
+            platform_atomic_store_uint32(&ring->producer_parked, 0);
+            return true;
+        }
+        platform_wait_on_address(&ring->producer_parked, 1, LOG_OVERFLOW_BLOCK_TIMEOUT_MS - (now - start));
+        platform_atomic_store_uint32(&ring->producer_parked, 0);
+
+        tail = platform_atomic_load_uint32(&ring->tail);
+        if (LOG_RING_BYTES - (head - tail) >= needed) {
+            return true;
+        }
+        platform_get_tick_count(&now);
+    } while (now - start < LOG_OVERFLOW_BLOCK_TIMEOUT_MS);
+
+    return false;
+}
+
+/**
+ * @brief Advances the tail of one of the calling thread's rings past its oldest records until needed bytes are free.
+ *
+ * Races with the logger are settled by compare-exchange on the tail: if the
+ * logger consumed the record first, the exchange fails and the tail is re-read.
+ *
+ * @param carried Receives the drop counts carried by the discarded entries, which must be passed on.
+ * @return The number of entries discarded.
+ */
+static uint32_t drop_oldest_records(LogRing_T* ring, uint32_t head, uint32_t needed, uint32_t* carried) {
+    const uint8_t* data = (const uint8_t*)ring->data;
+    uint32_t dropped = 0;
+    uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+    *carried = 0;
+
+    while (LOG_RING_BYTES - (head - tail) < needed) {
+        uint32_t offset = tail & LOG_RING_MASK;
+        uint32_t to_end = LOG_RING_BYTES - offset;
+        uint32_t size = to_end;  // Too little room left for a header, or a wrap record
+        bool is_entry = false;
+        uint32_t entry_dropped = 0;
+
+        if (to_end >= sizeof(LogRecordHeader_T)) {
+            LogRecordHeader_T header;
+            memcpy(&header, data + offset, sizeof(header));
+            if (header.label_id != LOG_RECORD_WRAP) {
+                size = header.size;
+                is_entry = true;
+                entry_dropped = header.dropped;
+            }
+        }
+
+        // On failure tail is reloaded with what the logger has consumed meanwhile
+        if (platform_atomic_compare_exchange_uint32(&ring->tail, &tail, tail + size)) {
+            tail += size;
+            if (is_entry) {
+                dropped++;
+                *carried += entry_dropped;
+            }
+        }
+    }
+    return dropped;
+}
+
+/**
+ * @brief Copies an entry into the calling thread's ring for a worker, applying the overflow policy.
+ */
+static LogPushResult push_record(LogQueue_T *log_queue, const LogEntry_T *entry, uint32_t worker) {
+    LogRing_T* ring = thread_rings[worker];
+    // Only the bytes in use are copied: deferred arguments, or the text without its terminator
+    size_t payload_size = entry->format ? entry->args_size
+                                        : strnlen(entry->message, sizeof(entry->message) - 1);
+    uint32_t record_size = LOG_RECORD_SIZE(payload_size);
+
+    // Only this thread writes head; the tail moves as the worker consumes
+    uint32_t head = platform_atomic_load_uint32(&ring->head);
+    uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+
+    logger_metrics_record_depth(head - tail);
+
+    uint32_t offset = head & LOG_RING_MASK;
+    uint32_t to_end = LOG_RING_BYTES - offset;
+    uint32_t skip = (to_end < record_size) ? to_end : 0;
+    uint32_t needed = skip + record_size;
+
+    LogOverflowPolicy policy = log_queue->overflow_policy;
+    if (policy == LOG_OVERFLOW_DROP_BELOW_LEVEL) {
+        policy = (entry->level < log_queue->overflow_level) ? LOG_OVERFLOW_DROP_NEWEST : LOG_OVERFLOW_BLOCK;
+    }
+    if (policy == LOG_OVERFLOW_BLOCK && thread_is_consumer) {
+        policy = LOG_OVERFLOW_DROP_NEWEST;  // Nothing else would ever make room
     }
 
-    // Check queue capacity and deal with any issues
-    handle_queue_capacity_state(get_queue_capacity(log_queue));
-
-    #define MAX_RETRY_ATTEMPTS 100
-    int attempt = 0;
-    
-    while (attempt < MAX_RETRY_ATTEMPTS) {
-        uint32_t head = platform_atomic_load_uint32(&log_queue->head);
-        uint32_t tail = platform_atomic_load_uint32(&log_queue->tail);
-        uint32_t next_head = (head + 1) % LOG_QUEUE_SIZE;
-
-        // Check if next slot would be tail
-        if (next_head == tail) {
-            // Handle overflow - we must acquire the mutex for this
-            lock_mutex(&logging_mutex);
-            
-            // After acquiring mutex, reread indices and recheck if full
-            head = platform_atomic_load_uint32(&log_queue->head);
-            tail = platform_atomic_load_uint32(&log_queue->tail);
-            
-            if ((head + 1) % LOG_QUEUE_SIZE == tail) {
-                // Queue is still full, need to purge some entries
-                int purge_count = LOG_QUEUE_SIZE/10;
-                LogEntry_T entry_1;
-                char msg[LOG_MSG_BUFFER_SIZE];
-                snprintf(msg, sizeof(msg), "Log queue overflow. Publishing oldest %d log entries immediately", purge_count);
-                create_log_entry(&entry_1, LOG_ERROR, msg);
-                // note: log_immediately does not acquire the mutex, log_now does.
-                log_immediately(&entry_1);
-                
-                while (purge_count > 0) {
-                    head = platform_atomic_load_uint32(&log_queue->head);
-                    tail = platform_atomic_load_uint32(&log_queue->tail);
-                    
-                    if (head == tail) break;
-                    
-                    LogEntry_T popped_entry;
-                    // Pop entries directly (not using log_queue_pop to avoid potential mutex deadlock)
-                    popped_entry = log_queue->entries[tail];
-                    uint32_t next_tail = (tail + 1) % LOG_QUEUE_SIZE;
-                    if (!platform_atomic_compare_exchange_uint32(&log_queue->tail, &tail, next_tail)) {
-                        // CAS failed - another thread modified tail
-                        // We should retry this iteration
-                        continue;
-                    }
-                    
-                    // Log the popped entry immediately
-                    log_immediately(&popped_entry);
-                    purge_count--;
+    // Under pressure, sampling thins the entries out before the ring is actually full
+    if (policy == LOG_OVERFLOW_SAMPLE && head - tail >= LOG_RING_BYTES / 2 &&
+        thread_sample_count++ % log_queue->sample_rate != 0) {
+        return drop_entries(log_queue, 1);
+    }
+
+    if (LOG_RING_BYTES - (head - tail) < needed) {
+        switch (policy) {
+            case LOG_OVERFLOW_BLOCK:
+                if (!wait_for_room(log_queue, worker, head, needed)) {
+                    return drop_entries(log_queue, 1);
                 }
-                
-                LogEntry_T entry_2;
-                create_log_entry(&entry_2, LOG_ERROR, "Log queue overflow. Purged complete");
-                log_immediately(&entry_2);
-                
-                unlock_mutex(&logging_mutex);
-            } else {
-                // Queue is no longer full, release mutex and try again
-                unlock_mutex(&logging_mutex);
+                break;
+            case LOG_OVERFLOW_DROP_OLDEST: {
+                uint32_t carried;
+                drop_entries(log_queue, drop_oldest_records(ring, head, needed, &carried));
+                thread_dropped += carried;
+                break;
             }
-            
-            // Try again from the beginning
-            attempt++; // Increment attempt counter
-            backoff_delay(attempt);
-            continue;
+            default:
+                return drop_entries(log_queue, 1);
+        }
+    }
+
+    uint8_t* data = (uint8_t*)ring->data;
+    if (skip) {
+        // Records never straddle the end of the arena
+        if (to_end >= sizeof(LogRecordHeader_T)) {
+            LogRecordHeader_T wrap = { .size = to_end, .label_id = LOG_RECORD_WRAP };
+            memcpy(data + offset, &wrap, sizeof(wrap));
         }
+        offset = 0;
+    }
+
+    LogRecordHeader_T header = {
+        .size = record_size,
+        .label_id = entry->label_id,
+        .payload_size = (uint16_t)payload_size,
+        .index = entry->index,
+        .timestamp = entry->timestamp,
+        .format = entry->format,
+        .level = (uint16_t)entry->level,
+        .route = entry->route,
+        .dropped = thread_dropped
+    };
+    memcpy(data + offset, &header, sizeof(header));
+    memcpy(data + offset + sizeof(header), entry->message, payload_size);
+    thread_dropped = 0;
+
+    platform_atomic_store_uint32(&ring->head, head + needed);
+
+    // The worker may have drained the ring and parked since tail was loaded, so every push
+    // checks; wake_consumer only does more than a load when the worker is parked
+    wake_consumer(log_queue, worker);
+    return LOG_PUSH_QUEUED;
+}
+
+/**
+ * @copydoc log_queue_push
+ */
+LogPushResult log_queue_push(LogQueue_T *log_queue, const LogEntry_T *entry, uint32_t worker) {
+    if (!entry || worker >= LOG_MAX_WORKERS) {
+        return LOG_PUSH_DROPPED;
+    }
+
+    if (!thread_rings[worker]) {
+        thread_rings[worker] = claim_ring(log_queue, worker);
+        if (!thread_rings[worker]) {
+            return LOG_PUSH_NO_RING;
+        }
+    }
+
+    // Timing every push would cost more than the push itself
+    if (thread_push_count++ % LOGGER_METRICS_PUSH_SAMPLE != 0) {
+        return push_record(log_queue, entry, worker);
+    }
+
+    PlatformHighResTimestamp_T start, end;
+    platform_get_high_res_timestamp(&start);
+    LogPushResult result = push_record(log_queue, entry, worker);
+    platform_get_high_res_timestamp(&end);
+    uint64_t elapsed_ns = 0;
+    platform_timestamp_elapsed(&start, &end, PLATFORM_TIME_GRANULARITY_NS, &elapsed_ns);
+    logger_metrics_record_push(elapsed_ns);
+    return result;
+}
+
+/**
+ * @brief Reads the header of the next record in a ring, skipping wrap records.
+ * @param ring The ring, read by its worker only.
+ * @param head The head of the ring as loaded by the worker; later records are left for the next scan.
+ * @param header Receives the record header.
+ * @param record_tail Receives the tail the record was found at, to consume it with.
+ * @return Pointer to the record in the arena, or NULL if the ring is empty.
+ */
+static const uint8_t* peek_record(LogRing_T* ring, uint32_t head, LogRecordHeader_T* header, uint32_t* record_tail) {
+    uint8_t* data = (uint8_t*)ring->data;
+    uint32_t tail = platform_atomic_load_uint32(&ring->tail);
+
+    while (tail != head) {
+        uint32_t offset = tail & LOG_RING_MASK;
+        uint32_t to_end = LOG_RING_BYTES - offset;
+
+        if (to_end >= sizeof(LogRecordHeader_T)) {
+            memcpy(header, data + offset, sizeof(*header));
+            if (header->label_id != LOG_RECORD_WRAP) {
+                *record_tail = tail;
+                return data + offset;
+            }
+        }
+
+        // Too little room left for a header, or an explicit wrap record.
+        // A drop_oldest producer may have moved the tail on, in which case it is reloaded.
+        if (platform_atomic_compare_exchange_uint32(&ring->tail, &tail, tail + to_end)) {
+            tail += to_end;
+            wake_producer(ring);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds the lowest-indexed record at the front of any of a worker's rings.
+ * @param queue The log queue.
+ * @param worker The worker.
+ * @param header Receives the record's header.
+ * @param record Receives the record's position in its ring.
+ * @param record_tail Receives the tail the record was found at.
+ * @return The ring holding the record, or NULL if every ring is empty.
+ */
+static LogRing_T* find_oldest_record(LogQueue_T *queue, uint32_t worker, LogRecordHeader_T* header,
+                                     const uint8_t** record, uint32_t* record_tail) {
+    LogRing_T* oldest = NULL;
+    uint32_t count = platform_atomic_load_uint32(&queue->ring_count);
 
-        // Check if current slot is already reserved or written
-        uint8_t state = platform_atomic_load_uint8(&log_queue->slot_states[head]);
-        if (state == SLOT_RESERVED || state == SLOT_WRITTEN) {
-            // Slot is either reserved or written, move to next slot
-            head = next_head;
-            attempt++; // Increment attempt counter
-            backoff_delay(attempt);
+    for (uint32_t i = 0; i < count; i++) {
+        LogRing_T* ring = &queue->rings[i];
+        // State is read first: a ring seen as retired has no pushes after this head load
+        uint32_t state = platform_atomic_load_uint32(&ring->state);
+        uint32_t head = platform_atomic_load_uint32(&ring->head);
+        // Read after the head, so the worker is never older than the records seen
+        if (platform_atomic_load_uint32(&ring->worker) != worker) {
             continue;
         }
+        LogRecordHeader_T ring_header;
+        uint32_t ring_tail;
+        const uint8_t* ring_record = peek_record(ring, head, &ring_header, &ring_tail);
 
-        // Try to reserve the slot with atomic compare-exchange
-        uint8_t expected_state = SLOT_EMPTY;
-        if (!platform_atomic_compare_exchange_uint8(
-                &log_queue->slot_states[head],
-                &expected_state,
-                SLOT_RESERVED)) {
-            // Another thread modified the state, try again
-            attempt++; // Increment attempt counter
-            backoff_delay(attempt);
+        if (!ring_record) {
+            // An exited thread's ring goes back to the pool once drained
+            if (state == LOG_RING_RETIRED) {
+                platform_atomic_compare_exchange_uint32(&ring->state, &state, LOG_RING_FREE);
+            }
             continue;
         }
-        
-        // Try to claim the slot
-        if (platform_atomic_compare_exchange_uint32(&log_queue->head, &head, next_head)) {
-            // Write entry
-            log_queue->entries[head] = *entry;
-            // Mark as fully written
-            platform_atomic_store_uint8(&log_queue->slot_states[head], SLOT_WRITTEN);
-            return true;
+
+        if (!oldest || ring_header.index < header->index) {
+            oldest = ring;
+            *header = ring_header;
+            *record = ring_record;
+            *record_tail = ring_tail;
         }
-        // If CAS failed, reset state and retry
-        platform_atomic_store_uint8(&log_queue->slot_states[head], SLOT_EMPTY);
-        attempt++; // Increment attempt counter
-        backoff_delay(attempt);
-    }
-    
-    // If we've reached here, we've failed after MAX_RETRY_ATTEMPTS
-    // Fall back to a guaranteed approach using the mutex
-    lock_mutex(&logging_mutex);
-    
-    // After acquiring mutex, check if we can now add to the queue
-    uint32_t head = platform_atomic_load_uint32(&log_queue->head);
-    uint32_t tail = platform_atomic_load_uint32(&log_queue->tail);
-    
-    if ((head + 1) % LOG_QUEUE_SIZE == tail) {
-        // Queue is still full, log directly
-        log_immediately(entry);
-        unlock_mutex(&logging_mutex);
-        return true;
-    } else {
-        // Queue has space now, add entry with mutex held
-        uint32_t new_head = (head + 1) % LOG_QUEUE_SIZE;
-        
-        // Write the entry
-        log_queue->entries[head] = *entry;
-        
-        // Mark as written
-        platform_atomic_store_uint8(&log_queue->slot_states[head], SLOT_WRITTEN);
-        
-        // Update head pointer
-        platform_atomic_store_uint32(&log_queue->head, new_head);
-        
-        unlock_mutex(&logging_mutex);
-        return true;
     }
+    return oldest;
 }
 
-
-bool log_queue_pop(LogQueue_T *queue, LogEntry_T *entry) {
-    if (!entry) {
+/**
+ * @copydoc log_queue_pop
+ */
+bool log_queue_pop(LogQueue_T *queue, uint32_t worker, LogEntry_T *entry) {
+    if (!entry || worker >= LOG_MAX_WORKERS) {
         return false;
     }
 
-    while (true) {
-        uint32_t tail = platform_atomic_load_uint32(&queue->tail);
-        uint32_t head = platform_atomic_load_uint32(&queue->head);
-
-        if (tail == head) {
+    for (;;) {
+        // Merge: take the lowest-indexed record at the front of any ring
+        LogRecordHeader_T header;
+        const uint8_t* record = NULL;
+        uint32_t tail = 0;
+        LogRing_T* oldest = find_oldest_record(queue, worker, &header, &record, &tail);
+        if (!oldest) {
             return false;
         }
 
-        // Only read if state is written 
-        if (platform_atomic_load_uint8(&queue->slot_states[tail]) != SLOT_WRITTEN) {
+        // Only a record overwritten under drop_oldest can look malformed, and then its tail has moved.
+        // A torn header must not send the copy past the entry or the end of the arena.
+        if (header.payload_size > sizeof(entry->message) - (header.format ? 0 : 1) ||
+            header.size != LOG_RECORD_SIZE(header.payload_size) ||
+            sizeof(header) + header.payload_size > LOG_RING_BYTES - (tail & LOG_RING_MASK)) {
             continue;
         }
 
-        uint32_t next_tail = (tail + 1) % LOG_QUEUE_SIZE;
-        if (platform_atomic_compare_exchange_uint32(&queue->tail, &tail, next_tail)) {
-            // Copy the entry
-            *entry = queue->entries[tail];
-            // Mark as available using the constant instead of 0
-            platform_atomic_store_uint8(&queue->slot_states[tail], SLOT_EMPTY);
+        entry->index = header.index;
+        entry->level = (LogLevel)header.level;
+        entry->timestamp = header.timestamp;
+        entry->format = header.format;
+        entry->args_size = header.format ? header.payload_size : 0;
+        entry->label_id = header.label_id;
+        entry->route = header.route;
+        entry->dropped = header.dropped;
+        memcpy(entry->message, record + sizeof(header), header.payload_size);
+        if (!header.format) {
+            entry->message[header.payload_size] = '\0';
+        }
+
+        // Fails if the producer dropped the record while it was being copied; take the next one instead
+        if (platform_atomic_compare_exchange_uint32(&oldest->tail, &tail, tail + header.size)) {
+            wake_producer(oldest);
             return true;
         }
     }
 }
 
-bool is_console_logging_suspended(void) {
-    return console_logging_suspended;
+/**
+ * @copydoc log_queue_depth_bytes
+ */
+uint32_t log_queue_depth_bytes(const LogQueue_T *queue) {
+    uint32_t depth = 0;
+    uint32_t count = platform_atomic_load_uint32(&queue->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        depth += platform_atomic_load_uint32(&queue->rings[i].head) -
+                 platform_atomic_load_uint32(&queue->rings[i].tail);
+    }
+    return depth;
+}
+
+/**
+ * @brief Tells whether a worker has nothing to consume, counting for worker 0 the workers it stands in for.
+ */
+static bool log_queue_is_empty(const LogQueue_T *queue, uint32_t worker) {
+    uint32_t count = platform_atomic_load_uint32(&queue->ring_count);
+    for (uint32_t i = 0; i < count; i++) {
+        const LogRing_T* ring = &queue->rings[i];
+        uint32_t head = platform_atomic_load_uint32(&ring->head);
+        uint32_t ring_worker = platform_atomic_load_uint32(&ring->worker);
+        bool consumed_here = ring_worker == worker ||
+                             (worker == 0 && !log_queue_worker_running(queue, ring_worker));
+        if (consumed_here && head != platform_atomic_load_uint32(&ring->tail)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @copydoc log_queue_wait
+ */
+bool log_queue_wait(LogQueue_T *queue, uint32_t worker, uint32_t timeout_ms) {
+    PlatformAtomicUInt32* parked = &queue->consumer_parked[worker];
+    platform_atomic_store_uint32(parked, 1);
+
+    // Re-check after announcing: a push that missed the flag is already visible here
+    if (log_queue_is_empty(queue, worker)) {
+        platform_wait_on_address(parked, 1, timeout_ms);
+    }
+
+    platform_atomic_store_uint32(parked, 0);
+    return !log_queue_is_empty(queue, worker);
+}
+
+/**
+ * @copydoc log_queue_release_thread_ring
+ */
+void log_queue_release_thread_ring(void) {
+    for (int i = 0; i < LOG_MAX_WORKERS; i++) {
+        if (thread_rings[i]) {
+            platform_atomic_store_uint32(&thread_rings[i]->state, LOG_RING_RETIRED);
+            thread_rings[i] = NULL;
+        }
+    }
 }
@@ -15,14 +15,22 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <stdbool.h>
-#include <math.h>
 #include <errno.h>
 
 #include "platform_time.h"
 #include "log_queue.h"
+#include "log_console.h"
+#include "log_deferred.h"
+#include "log_flight_recorder.h"
+#include "log_archive.h"
+#include "log_index.h"
+#include "log_maintenance.h"
+#include "log_network.h"
+#include "logger_metrics.h"
 #include "platform_threads.h"
 #include "platform_atomic.h"
 #include "platform_path.h"
+#include "platform_file.h"
 #include "platform_mutex.h"
 #include "platform_string.h"
 #include "platform_time.h"
@@ -33,6 +41,11 @@
 #include "app_config.h"
 
 #define MAX_LOG_FAILURES 100 // Maximum number of log failures before exiting
+#define LOGGER_SPIN_LIMIT 200        // Empty polls of the queue before the logger parks
+#define LOGGER_PARK_TIMEOUT_MS 100   // Longest park, so a shutdown is still noticed
+#define LOGGER_BATCH_SIZE 256        // Entries written per hold of a worker's mutex
+#define LOG_BATCH_BUFFER_SIZE 0x10000 // Output gathered per destination before it is written
+#define LOG_LINE_BUFFER_SIZE (2 * LOG_MSG_BUFFER_SIZE) // A formatted line, with room for a message escaped as JSON
 #define APP_LOG_FILE_INDEX 0
 
 /* ANSI colour codes (regular CMD on Windows supports limited colours) */
@@ -50,16 +63,58 @@
 
 extern const ThreadConfig ThreadConfigTemplate;
 
-extern bool console_logging_suspended;
+// A log line being built in a fixed buffer
+typedef struct LineWriter {
+    char *data;
+    size_t size;
+    size_t length;      // Length of the full line, which may exceed size
+} LineWriter;
+
+// Date and time text of the most recently logged second, kept per thread
+typedef struct LogTimeCache {
+    bool valid;
+    time_t second;
+    char text[32];
+    size_t length;
+    int64_t log_time;   // text as a log time, see log_index.h
+} LogTimeCache;
+
+// Formatted lines gathered for one destination, written out with a single call
+typedef struct LogBatch {
+    char *data;         // Allocated on first use
+    size_t length;
+    char *segment;      // Mapped log segment that lines are copied straight into instead, or NULL
+    size_t segment_size;
+    size_t segment_length;
+} LogBatch;
 
 // New structure to manage unique file pointers
 typedef struct LogFile {
     char file_name[MAX_PATH_LEN];
     FILE *fp;
+    PlatformMappedFileHandle segment;  // Used instead of fp by the mmap writer
     bool first_open;
     int ref_count;
+    LogBatch batch;
+    off_t bytes_written;        // Size of the file, counted as lines are written rather than queried
+    time_t opened_at;           // When the current file was started, for interval rotation
+    bool maintenance_pending;   // Rotated, not yet handed to the maintenance thread
+    uint64_t total_bytes;       // Written since start up, across rotations, for the metrics
+    uint32_t rotations;
+    int open_failures;          // Failed opens in a row
+    int directory_failures;     // Failures to create the file's directory, reported a few times only
+    FILE *index_fp;             // Sparse index of the file, see log_index.h, or NULL
+    uint32_t lines_since_index; // Lines written since the last index point
 } LogFile;
 
+// A logger thread and the log files it writes: file i belongs to worker i % g_log_worker_count
+typedef struct LogWorker {
+    PlatformMutex_T mutex;      // Guards the worker's LogFiles and serialises popping its entries;
+                                // taken before logging_mutex, never after
+    bool maintenance_pending;   // One of its LogFiles has maintenance_pending set
+    uint32_t last_flush_ticks;
+} LogWorker;
+
 // Table of unique log files
 static LogFile log_files[MAX_THREADS];
 static int g_log_file_count = 0;
@@ -73,6 +128,22 @@ typedef struct ThreadLogFile {
     bool first_open;  // Keeping this temporarily until we migrate functionality
 } ThreadLogFile;
 
+typedef enum LogFormat {
+    LOG_FORMAT_TEXT,   // "<index> <date> <time> <level>: [<label>] <message>"
+    LOG_FORMAT_JSON    // One JSON object per line, see docs/LOG_FORMAT_SPEC.md
+} LogFormat;
+
+typedef enum LogWriter {
+    LOG_WRITER_STDIO,  // Lines are written to the file through stdio
+    LOG_WRITER_MMAP    // Lines are copied into a preallocated, memory-mapped segment
+} LogWriter;
+
+typedef enum LogFlushPolicy {
+    LOG_FLUSH_EVERY_ENTRY,  // Write and flush each line as it is logged
+    LOG_FLUSH_BATCH,        // Write and flush once per batch drained by the logger thread
+    LOG_FLUSH_INTERVAL      // Write and flush at most every g_log_flush_interval_ms
+} LogFlushPolicy;
+
 typedef enum LogTimestampGranularity {
     LOG_TS_NANOSECOND  = 1000000000, // 1/1,000,000,000 (default) 
     LOG_TS_MICROSECOND = 1000000,    // 1/1,000,000
@@ -87,13 +158,29 @@ typedef enum LogTimestampGranularity {
 bool g_trace_all = false;
 #endif
 
-PlatformMutex_T logging_mutex; // Mutex for thread safety
+PlatformMutex_T logging_mutex; // Guards the file and route tables, screen output and the network sink
+static PlatformMutex_T label_mutex; // Guards interning of thread labels
+
+// Interned thread labels, indexed by label id. Id 0 is reserved for unlabelled threads.
+static char g_log_labels[MAX_LOG_LABELS][THREAD_LABEL_SIZE] = { "UNKNOWN" };
+static PlatformAtomicUInt32 g_log_label_count = { 1 };
 static ThreadLogFile thread_log_files[MAX_THREADS + 1]; // +1 for the main application log file
+// thread_log_files index for each label id, resolved when the thread's log file is set; 0 is the main log.
+// Stored once the ThreadLogFile is set up, so whoever loads a route can use it without the logging mutex.
+static PlatformAtomicUInt8 g_label_log_routes[MAX_LOG_LABELS];
+// Level of each label plus one, or 0 where the global level applies
+static uint8_t g_label_log_levels[MAX_LOG_LABELS];
+// Bumped on every level change, so threads know to refresh their cached level
+static PlatformAtomicUInt32 g_log_level_generation = { 1 };
+_Static_assert(MAX_THREADS < 256, "log routes are stored as uint8_t");
 
 // Replace Windows-specific timestamp types with platform-agnostic ones
 static THREAD_LOCAL int g_timestamp_initialised = 0;
 
 static LogTimestampGranularity g_log_timestamp_granularity = LOG_TS_NANOSECOND;  // Default
+static int g_log_fraction_width = 9;              // Digits of fractional seconds shown
+static uint32_t g_log_fraction_divisor = 1;       // Nanoseconds per displayed fractional unit
+static THREAD_LOCAL LogTimeCache g_log_time_cache;
 
 
 #ifdef _DEBUG
@@ -116,14 +203,32 @@ static int g_thread_log_file_count = 0;
 static char log_file_path[MAX_PATH_LEN] = "";             // Log file path
 static char log_file_name[MAX_PATH_LEN] = "log_file.log"; // Log file name
 static off_t g_log_file_size = 10485760;                  // Log file size before rotation
+static time_t g_log_rotate_interval_s = 0;                // Age at which a log file is rotated, 0 for never
+static uint32_t g_log_metrics_interval_s = 0;             // Period of the metrics summary line, 0 for none
+static uint32_t g_log_rate_limit_interval_ms = 6000;      // Credit per entry at a rate-limited site
+static uint32_t g_log_rate_limit_burst = 5;               // Entries a rate-limited site can log at once
 
 static PlatformThreadHandle log_thread; // Logging thread
 static bool logging_thread_started = false; // indicate whether the logger thread has started
 static bool g_purge_logs_on_restart = false;
+static bool g_deferred_formatting = false;   // Capture raw arguments, format on the logger thread
+static LogFlushPolicy g_log_flush = LOG_FLUSH_BATCH;
+static LogWriter g_log_writer = LOG_WRITER_STDIO;
+static LogFormat g_log_format = LOG_FORMAT_TEXT;  // Of log files and the network sink; the screen is always text
+static uint32_t g_log_flush_interval_ms = 100;
+static uint32_t g_log_index_interval = 1000;  // Lines per point of each log file's index, 0 for no index
+static LogWorker g_log_workers[LOG_MAX_WORKERS];
+static uint32_t g_log_worker_count = 1;      // Worker 0 is the LOGGER thread
+static LogBatch g_console_batch;             // Lines bound for stderr
+static LogLineRing* g_console_ring = NULL;   // Screen lines go here while the console sink runs
  
 void init_logger_mutex(void) {
     /* Initialise the mutex, vital this is down before any logging */
     init_mutex(&logging_mutex);
+    init_mutex(&label_mutex);
+    for (int i = 0; i < LOG_MAX_WORKERS; i++) {
+        init_mutex(&g_log_workers[i].mutex);
+    }
 }
  
  /**
@@ -147,6 +252,91 @@ void init_logger_mutex(void) {
      return default_granularity;  // Fallback if value is unrecognized
  }
  
+ /**
+  * @brief Convert a flush policy string to the corresponding enum.
+  * @param policy_str The string representing the flush policy.
+  * @param default_policy The default policy if the string is invalid.
+  * @return The corresponding LogFlushPolicy value.
+  */
+ static LogFlushPolicy log_flush_policy_from_string(const char* policy_str, LogFlushPolicy default_policy) {
+     if (!policy_str) return default_policy;
+
+     if (strcmp_nocase(policy_str, "every_entry") == 0) return LOG_FLUSH_EVERY_ENTRY;
+     if (strcmp_nocase(policy_str, "batch") == 0) return LOG_FLUSH_BATCH;
+     if (strcmp_nocase(policy_str, "interval_ms") == 0 ||
+         strcmp_nocase(policy_str, "interval") == 0) return LOG_FLUSH_INTERVAL;
+
+     return default_policy;
+ }
+
+ /**
+  * @brief Convert an overflow policy string to the corresponding enum.
+  * @param policy_str The string representing the overflow policy.
+  * @param default_policy The default policy if the string is invalid.
+  * @return The corresponding LogOverflowPolicy value.
+  */
+ static LogOverflowPolicy log_overflow_policy_from_string(const char* policy_str, LogOverflowPolicy default_policy) {
+     if (!policy_str) return default_policy;
+
+     if (strcmp_nocase(policy_str, "block") == 0) return LOG_OVERFLOW_BLOCK;
+     if (strcmp_nocase(policy_str, "drop_newest") == 0) return LOG_OVERFLOW_DROP_NEWEST;
+     if (strcmp_nocase(policy_str, "drop_oldest") == 0) return LOG_OVERFLOW_DROP_OLDEST;
+     if (strcmp_nocase(policy_str, "drop_below_level") == 0) return LOG_OVERFLOW_DROP_BELOW_LEVEL;
+     if (strcmp_nocase(policy_str, "sample") == 0) return LOG_OVERFLOW_SAMPLE;
+
+     return default_policy;
+ }
+
+ /**
+  * @brief Convert a log writer string to the corresponding enum.
+  * @param writer_str "stdio" or "mmap".
+  * @param default_writer The default writer if the string is invalid.
+  * @return The corresponding LogWriter value.
+  */
+ static LogWriter log_writer_from_string(const char* writer_str, LogWriter default_writer) {
+     if (!writer_str) return default_writer;
+
+     if (strcmp_nocase(writer_str, "stdio") == 0) return LOG_WRITER_STDIO;
+     if (strcmp_nocase(writer_str, "mmap") == 0) return LOG_WRITER_MMAP;
+
+     return default_writer;
+ }
+
+ /**
+  * @brief Convert a log format string to the corresponding enum.
+  * @param format_str "text" or "json".
+  * @param default_format The default format if the string is invalid.
+  * @return The corresponding LogFormat value.
+  */
+ static LogFormat log_format_from_string(const char* format_str, LogFormat default_format) {
+     if (!format_str) return default_format;
+
+     if (strcmp_nocase(format_str, "text") == 0) return LOG_FORMAT_TEXT;
+     if (strcmp_nocase(format_str, "json") == 0) return LOG_FORMAT_JSON;
+
+     return default_format;
+ }
+
+ /**
+  * @brief Convert a rotation interval string to seconds.
+  * @param interval_str "none", "hourly", "daily" or a number of seconds.
+  * @param default_interval The default interval if the string is invalid.
+  * @return The interval in seconds, 0 meaning no time-based rotation.
+  */
+ static time_t log_rotate_interval_from_string(const char* interval_str, time_t default_interval) {
+     if (!interval_str) return default_interval;
+
+     if (strcmp_nocase(interval_str, "none") == 0) return 0;
+     if (strcmp_nocase(interval_str, "hourly") == 0) return 3600;
+     if (strcmp_nocase(interval_str, "daily") == 0) return 86400;
+
+     char* end = NULL;
+     long seconds = strtol(interval_str, &end, 10);
+     if (end != interval_str && *end == '\0' && seconds >= 0) return (time_t)seconds;
+
+     return default_interval;
+ }
+
  /**
   * @brief Convert a log level string to the corresponding LogLevel enum.
   * @param level_str The string representing the log level.
@@ -210,16 +400,144 @@ void init_logger_mutex(void) {
  }
  
  /**
-  * @brief Publishes a log entry to the appropriate destination (file or console).
-  * @param entry The log entry.
-  * @param log_output The file pointer (typically stderr for screen output).
+  * @brief Writes out a destination's gathered lines and flushes the stream.
   */
- static void publish_log_entry(const LogEntry_T* entry, FILE* log_output) {
-     if (!entry || entry->message[0] == '\0') {
-         stream_print(stderr, "Log Error: Attempted to log NULL or blank message\n");
+ static void write_log_batch(LogBatch* batch, FILE* log_output) {
+     if (batch->length > 0 && log_output) {
+         platform_write(log_output, batch->data, batch->length);
+     }
+     batch->length = 0;
+     if (log_output) {
+         fflush(log_output);
+     }
+ }
+
+ /**
+  * @brief Adds a formatted line to a destination's batch, writing out the batch first if full.
+  */
+ static void append_log_batch(LogBatch* batch, FILE* log_output, const char* line, size_t length) {
+     if (batch->segment) {
+         // No system call: the page cache writes the segment back. Rotation keeps a line's worth of room.
+         if (batch->segment_size - batch->segment_length >= length) {
+             memcpy(batch->segment + batch->segment_length, line, length);
+             batch->segment_length += length;
+         }
          return;
      }
- 
+
+     if (g_log_flush == LOG_FLUSH_EVERY_ENTRY) {
+         platform_write(log_output, line, length);
+         fflush(log_output);
+         return;
+     }
+
+     if (!batch->data) {
+         batch->data = malloc(LOG_BATCH_BUFFER_SIZE);
+         if (!batch->data) {
+             platform_write(log_output, line, length);
+             return;
+         }
+     }
+
+     if (batch->length + length > LOG_BATCH_BUFFER_SIZE) {
+         write_log_batch(batch, log_output);
+     }
+     memcpy(batch->data + batch->length, line, length);
+     batch->length += length;
+ }
+
+ /**
+  * @brief Gets the number of LogFiles set up so far; those below it stay where they are.
+  */
+ static int get_log_file_count(void) {
+     lock_mutex(&logging_mutex);
+     int count = g_log_file_count;
+     unlock_mutex(&logging_mutex);
+     return count;
+ }
+
+ static uint32_t log_file_worker(const LogFile* log_file) {
+     return (uint32_t)(log_file - log_files) % g_log_worker_count;
+ }
+
+ /**
+  * @brief Writes out the gathered lines of a worker's files and of the screen. The worker's mutex must be held.
+  */
+ static void write_all_log_batches(uint32_t worker) {
+     int count = get_log_file_count();
+     for (int i = (int)worker; i < count; i += (int)g_log_worker_count) {
+         write_log_batch(&log_files[i].batch, log_files[i].fp);
+         if (log_files[i].index_fp) {
+             fflush(log_files[i].index_fp);
+         }
+     }
+     lock_mutex(&logging_mutex);
+     write_log_batch(&g_console_batch, stderr);
+     unlock_mutex(&logging_mutex);
+ }
+
+ /**
+  * @brief Writes out gathered lines if the flush policy calls for it. The worker's mutex must be held.
+  * @param worker The worker whose files are written out.
+  * @param batch_end True at the end of a batch drained by the worker.
+  */
+ static void flush_log_batches_if_due(uint32_t worker, bool batch_end) {
+     uint32_t now = 0;
+     switch (g_log_flush) {
+         case LOG_FLUSH_EVERY_ENTRY:
+             return;  // Nothing is held back
+         case LOG_FLUSH_BATCH:
+             if (batch_end) {
+                 write_all_log_batches(worker);
+             }
+             return;
+         case LOG_FLUSH_INTERVAL:
+             platform_get_tick_count(&now);
+             if (now - g_log_workers[worker].last_flush_ticks >= g_log_flush_interval_ms) {
+                 write_all_log_batches(worker);
+                 g_log_workers[worker].last_flush_ticks = now;
+             }
+             return;
+     }
+ }
+
+ /**
+  * @brief Appends text to a log line, counting what does not fit as snprintf would.
+  */
+ static void line_put(LineWriter* line, const char* text, size_t length) {
+     if (line->length < line->size) {
+         size_t room = line->size - line->length;
+         memcpy(line->data + line->length, text, length < room ? length : room);
+     }
+     line->length += length;
+ }
+
+ static void line_put_str(LineWriter* line, const char* text) {
+     line_put(line, text, strlen(text));
+ }
+
+ /**
+  * @brief Appends an unsigned integer zero-padded to at least width digits, as "%0*llu".
+  */
+ static void line_put_padded_uint(LineWriter* line, uint64_t value, int width) {
+     char digits[20];
+     int count = 0;
+     do {
+         digits[sizeof(digits) - 1 - count++] = (char)('0' + value % 10);
+         value /= 10;
+     } while (value != 0);
+
+     for (int i = count; i < width; i++) {
+         line_put(line, "0", 1);
+     }
+     line_put(line, digits + sizeof(digits) - count, (size_t)count);
+ }
+
+ /**
+  * @brief Brings the calling thread's date and time text up to the second of an entry.
+  * @return The nanoseconds within that second.
+  */
+ static int64_t update_log_time_cache(const LogEntry_T* entry) {
      /* Initialise the timestamp system for the current thread if not already initialised */
      if (!g_timestamp_initialised) {
          // This should never happen, the timing system needs to be initialized
@@ -233,57 +551,196 @@ void init_logger_mutex(void) {
          sleep_ms(500);
      }
  
-     /* Calculate calendar time from high-resolution timestamp */
+     /* Calendar time from the high-resolution timestamp; plain arithmetic, no libc */
      time_t rawtime;
      int64_t nanoseconds;
      platform_timestamp_to_calendar_time(&entry->timestamp, &rawtime, &nanoseconds);
  
-     /* Format time using platform-independent function */
-     struct tm timeinfo;
-     platform_localtime(&rawtime, &timeinfo);
+     /* The date and time change at most once a second, so format them only then */
+     if (!g_log_time_cache.valid || g_log_time_cache.second != rawtime) {
+         struct tm timeinfo;
+         platform_localtime(&rawtime, &timeinfo);
+         g_log_time_cache.length = strftime(g_log_time_cache.text, sizeof(g_log_time_cache.text),
+                                            "%Y-%m-%d %H:%M:%S", &timeinfo);
+         g_log_time_cache.second = rawtime;
+         g_log_time_cache.valid = true;
+         log_archive_parse_time(g_log_time_cache.text, &g_log_time_cache.log_time);
+     }
+     return nanoseconds;
+ }
+
+ /**
+  * @brief Formats the line of a log entry: index, date and time, fraction, level, label, message.
+  * @param entry The log entry.
+  * @param message The formatted message text of the entry.
+  * @param use_colour Whether to colour the level with ANSI codes.
+  * @param log_buffer Destination for the line.
+  * @param size Size of the destination.
+  * @return The length of the line including its newline, or 0 if it does not fit.
+  */
+ static size_t format_log_line(const LogEntry_T* entry, const char* message, bool use_colour,
+                               char* log_buffer, size_t size) {
+     int64_t nanoseconds = update_log_time_cache(entry);
+     int index_width = (g_log_leading_zeros >= 0) ? g_log_leading_zeros : 12;
  
-     /* Calculate fractional part */
-     int64_t adjusted_time = nanoseconds / (1000000000 / g_log_timestamp_granularity);
+     /* Build the line: index, date and time, fraction, level, label, message */
+     LineWriter line = { log_buffer, size, 0 };
+     line_put_padded_uint(&line, entry->index, index_width);
+     line_put(&line, " ", 1);
+     line_put(&line, g_log_time_cache.text, g_log_time_cache.length);
+     if (g_log_fraction_width > 0) {
+         line_put(&line, ".", 1);
+         line_put_padded_uint(&line, (uint64_t)nanoseconds / g_log_fraction_divisor, g_log_fraction_width);
+     }
+     line_put(&line, " ", 1);
+     if (use_colour) {
+         line_put_str(&line, get_log_level_colour(entry->level));
+     }
+     line_put_str(&line, log_level_to_string(entry->level));
+     if (use_colour) {
+         line_put_str(&line, ANSI_RESET);
+     }
+     line_put(&line, ": [", 3);
+     line_put_str(&line, logger_label_name(entry->label_id));
+     line_put(&line, "] ", 2);
+     line_put_str(&line, message);
+     line_put(&line, "\n", 1);
  
-     /* Rest of the existing code remains the same */
-     int fractional_width = (int)log10((double)g_log_timestamp_granularity);
-     int index_width = (g_log_leading_zeros >= 0) ? g_log_leading_zeros : 12;
-     const char* log_colour = (log_output == stderr && g_log_use_ansi_colours) ? get_log_level_colour(entry->level) : "";
-     const char* reset_colour = (log_output == stderr && g_log_use_ansi_colours) ? "\x1b[0m" : "";
- 
-     char time_buffer[64];
-     strftime(time_buffer, sizeof(time_buffer), "%Y-%m-%d %H:%M:%S", &timeinfo);
- 
-     /* Print the log entry */
-     if (fractional_width > 0) {
-         char log_buffer[LOG_MSG_BUFFER_SIZE];
-         size_t written = snprintf(log_buffer, sizeof(log_buffer),
-             "%0*llu %s.%0*lld %s%s%s: [%s] %s\n",
-             index_width, entry->index,
-             time_buffer,
-             fractional_width, adjusted_time,
-             log_colour, log_level_to_string(entry->level), reset_colour,
-             entry->thread_label,
-             entry->message);
-         if (written > 0 && written < sizeof(log_buffer)) {
-             stream_print(log_output, "%s", log_buffer);
+     /* As before, a line that does not fit the buffer is dropped rather than cut */
+     return (line.length < size) ? line.length : 0;
+ }
+
+ // What each byte becomes inside a JSON string: 0 to copy it, 'u' for \u00XX, else the letter after a backslash
+ static const char g_json_escapes[256] = {
+     'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+     'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+     ['"'] = '"', ['\\'] = '\\'
+ };
+
+ // Level names in JSON lines, unpadded and for every level
+ static const char* g_json_level_names[] = {
+     "TRACE", "DEBUG", "INFO", "NOTICE", "WARN", "ERROR", "CRITICAL", "FATAL"
+ };
+
+ /**
+  * @brief Checks 8 bytes at once for any that JSON needs escaped: below 0x20, '"' or '\\'.
+  */
+ static bool json_word_needs_escape(uint64_t word) {
+     const uint64_t ones = 0x0101010101010101ull;
+     const uint64_t highs = 0x8080808080808080ull;
+     uint64_t quotes = word ^ (ones * '"');
+     uint64_t backslashes = word ^ (ones * '\\');
+     // A byte's high bit is set in each term where it is below 0x20, or is zero after the XOR
+     uint64_t found = ((word - ones * 0x20) | (quotes - ones) | (backslashes - ones)) &
+                      ~word & highs;
+     return found != 0;
+ }
+
+ /**
+  * @brief Appends text as the contents of a JSON string.
+  *
+  * Runs of bytes that need no escaping, which is nearly all of a typical
+  * message, are skipped 8 bytes at a time and copied in one go; the table
+  * then says how to escape the byte that ended the run. Bytes from 0x80 up
+  * are copied as they are, so UTF-8 passes through.
+  */
+ static void line_put_json_string(LineWriter* line, const char* text) {
+     static const char hex_digits[] = "0123456789abcdef";
+     const unsigned char* run = (const unsigned char*)text;
+     const unsigned char* p = run;
+     const unsigned char* end = p + strlen(text);
+
+     while (p < end) {
+         uint64_t word;
+         if (end - p >= 8 && (memcpy(&word, p, sizeof(word)), !json_word_needs_escape(word))) {
+             p += 8;
+             continue;
          }
-     }
-     else {
-         char log_buffer[LOG_MSG_BUFFER_SIZE];
-         size_t written = snprintf(log_buffer, sizeof(log_buffer),
-             "%0*llu %s %s%s%s: [%s] %s\n",
-             index_width, entry->index,
-             time_buffer,
-             log_colour, log_level_to_string(entry->level), reset_colour,
-             entry->thread_label,
-             entry->message);
-         if (written > 0 && written < sizeof(log_buffer)) {
-             stream_print(log_output, "%s", log_buffer);
+         char escape = g_json_escapes[*p];
+         if (!escape) {
+             p++;
+             continue;
+         }
+         line_put(line, (const char*)run, (size_t)(p - run));
+         if (escape == 'u') {
+             char code[6] = { '\\', 'u', '0', '0', hex_digits[*p >> 4], hex_digits[*p & 0xF] };
+             line_put(line, code, sizeof(code));
+         } else {
+             char pair[2] = { '\\', escape };
+             line_put(line, pair, sizeof(pair));
          }
+         run = ++p;
      }
- 
-     fflush(log_output);
+     line_put(line, (const char*)run, (size_t)(p - run));
+ }
+
+ /**
+  * @brief Formats a log entry as a line holding one JSON object, see docs/LOG_FORMAT_SPEC.md.
+  * @param entry The log entry.
+  * @param message The formatted message text of the entry.
+  * @param log_buffer Destination for the line.
+  * @param size Size of the destination.
+  * @return The length of the line including its newline, or 0 if it does not fit.
+  */
+ static size_t format_json_log_line(const LogEntry_T* entry, const char* message, char* log_buffer, size_t size) {
+     int64_t nanoseconds = update_log_time_cache(entry);
+
+     /* Fields always in this order, so a reader can pick out the index and time without parsing the rest */
+     LineWriter line = { log_buffer, size, 0 };
+     line_put_str(&line, "{\"index\":");
+     line_put_padded_uint(&line, entry->index, 1);
+     line_put_str(&line, ",\"timestamp\":\"");
+     line_put(&line, g_log_time_cache.text, 10);
+     line_put(&line, "T", 1);
+     line_put(&line, g_log_time_cache.text + 11, g_log_time_cache.length - 11);
+     if (g_log_fraction_width > 0) {
+         line_put(&line, ".", 1);
+         line_put_padded_uint(&line, (uint64_t)nanoseconds / g_log_fraction_divisor, g_log_fraction_width);
+     }
+     line_put_str(&line, "\",\"level\":\"");
+     line_put_str(&line, (unsigned)entry->level < sizeof(g_json_level_names) / sizeof(g_json_level_names[0])
+                         ? g_json_level_names[entry->level] : "UNKNOWN");
+     line_put_str(&line, "\",\"label\":\"");
+     line_put_json_string(&line, logger_label_name(entry->label_id));
+     line_put_str(&line, "\",\"message\":\"");
+     line_put_json_string(&line, message);
+     line_put(&line, "\"}\n", 3);
+
+     return (line.length < size) ? line.length : 0;
+ }
+
+ /**
+  * @brief Formats the line of a log entry for a log file or the network sink, in the configured format.
+  */
+ static size_t format_output_line(const LogEntry_T* entry, const char* message, char* log_buffer, size_t size) {
+     if (g_log_format == LOG_FORMAT_JSON) {
+         return format_json_log_line(entry, message, log_buffer, size);
+     }
+     return format_log_line(entry, message, false, log_buffer, size);
+ }
+
+ /**
+  * @brief Publishes a log entry to the appropriate destination (file or console).
+  * @param entry The log entry.
+  * @param message The formatted message text of the entry.
+  * @param log_output The file pointer (typically stderr for screen output).
+  * @param batch The batch gathering output for log_output.
+  * @return The number of bytes appended to the batch.
+  */
+ static size_t publish_log_entry(const LogEntry_T* entry, const char* message, FILE* log_output, LogBatch* batch) {
+     if (!entry || !message || message[0] == '\0') {
+         stream_print(stderr, "Log Error: Attempted to log NULL or blank message\n");
+         return 0;
+     }
+
+     char log_buffer[LOG_LINE_BUFFER_SIZE];
+     size_t length = (log_output == stderr)
+         ? format_log_line(entry, message, g_log_use_ansi_colours, log_buffer, sizeof(log_buffer))
+         : format_output_line(entry, message, log_buffer, sizeof(log_buffer));
+     if (length > 0) {
+         append_log_batch(batch, log_output, log_buffer, length);
+     }
+     return length;
  }
  
  
@@ -310,6 +767,9 @@ void init_logger_mutex(void) {
   * @param filename The log file name to set.
   */
  void set_log_thread_file(const char *label, const char *filename) {
+     // Entries carry the label id, so routing by it on the logger thread is a table lookup
+     uint16_t label_id = logger_intern_label(label);
+
      lock_mutex(&logging_mutex); // Lock the mutex
 
      if (g_thread_log_file_count >= MAX_THREADS) {
@@ -337,64 +797,117 @@ void init_logger_mutex(void) {
          log_file = &log_files[g_log_file_count++];
          platform_strcat(log_file->file_name, filename, sizeof(log_file->file_name));
          log_file->fp = NULL;
+         log_file->segment = NULL;
          log_file->first_open = false;
          log_file->ref_count = 1;
+         log_file->open_failures = 0;
+         log_file->directory_failures = 0;
      }
 
      // Link the ThreadLogFile to the LogFile
      thread_log_files[g_thread_log_file_count].log_file = log_file;
      thread_log_files[g_thread_log_file_count].first_open = false;
 
+     // Unknown and overflow labels share id 0, which must stay routed to the main log
+     if (label_id != 0 && log_file != NULL) {
+         platform_atomic_store_uint8(&g_label_log_routes[label_id], (uint8_t)g_thread_log_file_count);
+     }
+
      g_thread_log_file_count++;
 
      unlock_mutex(&logging_mutex); // Unlock the mutex
 }
 
-static const char* find_parent_log_file(const char* thread_label) {
+/**
+ * @brief Finds a per-thread setting configured for a parent of a dotted thread label.
+ * @param thread_label The thread label, e.g. "client.receive".
+ * @param key The setting, e.g. CONFIG_LOG_FILE_KEY.
+ * @return The value for the nearest parent that has one, or NULL.
+ */
+static const char* find_parent_config(const char* thread_label, const char* key) {
     char parent_label[MAX_PATH_LEN];
     char config_key[MAX_PATH_LEN];
-    const char* log_file = NULL;
+    const char* value = NULL;
     
     // Make a copy we can modify
     strncpy(parent_label, thread_label, sizeof(parent_label) - 1);
     parent_label[sizeof(parent_label) - 1] = '\0';
     
     // Keep checking parent levels until we find a config or run out of dots
-    while (strchr(parent_label, '.') != NULL && !log_file) {
+    while (strchr(parent_label, '.') != NULL && !value) {
         // Remove the last segment
         char* last_dot = strrchr(parent_label, '.');
         *last_dot = '\0';
         
-        // Check if this parent has a log file configured
-        snprintf(config_key, sizeof(config_key), "%s." CONFIG_LOG_FILE_KEY, parent_label);
-        log_file = get_config_string("logger", config_key, NULL);
+        // Check if this parent has the setting configured; a truncated key could match another entry
+        int written = snprintf(config_key, sizeof(config_key), "%s.%s", parent_label, key);
+        if (written < 0 || (size_t)written >= sizeof(config_key)) {
+            break;
+        }
+        value = get_config_string("logger", config_key, NULL);
     }
     
-    return log_file;
+    return value;
+}
+
+/**
+ * @brief Reads a per-thread setting, from the full thread label or else its nearest parent.
+ */
+static const char* get_thread_config_string(const char* thread_label, const char* key) {
+    char config_key[MAX_PATH_LEN];
+
+    snprintf(config_key, sizeof(config_key), "%s.%s", thread_label, key);
+    const char* value = get_config_string("logger", config_key, NULL);
+    if (!value && strchr(thread_label, '.')) {
+        value = find_parent_config(thread_label, key);
+    }
+    return value;
+}
+
+/**
+ * @brief Sets the level of an interned label, 0 being the shared id that keeps the global level.
+ */
+static void set_label_level(uint16_t label_id, LogLevel level) {
+    if (label_id == 0 || label_id >= MAX_LOG_LABELS) {
+        return;
+    }
+    g_label_log_levels[label_id] = (uint8_t)(level + 1);
+    platform_atomic_fetch_add_uint32(&g_log_level_generation, 1);
 }
 
 void set_thread_log_file_from_config(const char* thread_label) {
-    char file_config_key[MAX_PATH_LEN];
     const char* config_thread_log_file = NULL;
     const char* config_thread_log_path = get_config_string("logger", CONFIG_LOG_PATH_KEY, NULL);
 
     /* Read log level from config */
     const char* config_log_level = get_config_string("logger", "log_level", NULL);
-    g_log_level = log_level_from_string(config_log_level, g_log_level);
+    LogLevel log_level = log_level_from_string(config_log_level, g_log_level);
+    if (log_level != g_log_level) {
+        logger_set_level(log_level);
+    }
 
 #ifdef _DEBUG
     g_trace_all = get_config_bool("debug", "trace_on", false);
 #endif
 
-    // First try the full thread label
-    snprintf(file_config_key, sizeof(file_config_key), "%s." CONFIG_LOG_FILE_KEY, thread_label);
-    config_thread_log_file = get_config_string("logger", file_config_key, NULL);
+    // A restarted thread keeps the file it was routed to; the config is only searched once per label
+    uint16_t label_id = logger_intern_label(thread_label);
 
-    // If not found, try all parent levels
-    if (!config_thread_log_file && strchr(thread_label, '.')) {
-        config_thread_log_file = find_parent_log_file(thread_label);
+    /* A level for the thread's label, e.g. client.log_level=TRACE, overrides the global one */
+    const char* config_thread_log_level = get_thread_config_string(thread_label, "log_level");
+    if (config_thread_log_level) {
+        set_label_level(label_id, log_level_from_string(config_thread_log_level, g_log_level));
     }
 
+    bool already_routed = label_id != 0 &&
+                          platform_atomic_load_uint8(&g_label_log_routes[label_id]) != APP_LOG_FILE_INDEX;
+    if (already_routed) {
+        return;
+    }
+
+    // The full thread label first, then all parent levels
+    config_thread_log_file = get_thread_config_string(thread_label, CONFIG_LOG_FILE_KEY);
+
     /* Configure log file */
     if (config_thread_log_file) {
         if (config_thread_log_path) {
@@ -453,37 +966,133 @@ void set_thread_log_file_from_config(const char* thread_label) {
      return false;
  }
 
+ static bool log_file_is_open(const LogFile *log_file) {
+     return log_file->fp != NULL || log_file->segment != NULL;
+ }
+
+ /**
+  * @brief Maps a preallocated segment for a log file, appending to any existing content.
+  * @param truncate Discard the existing content instead.
+  */
+ static bool open_log_segment(LogFile *log_file, bool truncate) {
+     struct stat st;
+     off_t existing = (!truncate && stat(log_file->file_name, &st) == 0) ? st.st_size : 0;
+
+     // Room for one more line past the rotation size, as rotation is checked before each line
+     size_t size = (size_t)(existing > g_log_file_size ? existing : g_log_file_size) + LOG_LINE_BUFFER_SIZE;
+     PlatformMappedFileHandle segment = platform_mapped_file_open(log_file->file_name, size, truncate, NULL);
+     if (!segment) {
+         return false;
+     }
+
+     // A segment that was not closed cleanly still ends in its preallocated zeros
+     char* data = platform_mapped_file_data(segment);
+     size_t used = (size_t)existing;
+     while (used > 0 && data[used - 1] == '\0') {
+         used--;
+     }
+
+     log_file->segment = segment;
+     log_file->batch.segment = data;
+     log_file->batch.segment_size = platform_mapped_file_size(segment);
+     log_file->batch.segment_length = used;
+     log_file->bytes_written = (off_t)used;
+     return true;
+ }
+
+ /**
+  * @brief Unmaps a log file's segment, cutting the file to the bytes written.
+  */
+ static bool close_log_segment(LogFile *log_file) {
+     PlatformErrorCode err = platform_mapped_file_close(log_file->segment, log_file->batch.segment_length);
+     log_file->segment = NULL;
+     log_file->batch.segment = NULL;
+     log_file->batch.segment_size = 0;
+     log_file->batch.segment_length = 0;
+     return err == PLATFORM_ERROR_SUCCESS;
+ }
+
+ /**
+  * @brief Opens a log file's index alongside it, if log files are indexed.
+  * @param truncate Discard any existing index, as the log file itself is.
+  */
+ static void open_log_index(LogFile *log_file, bool truncate) {
+     log_file->lines_since_index = 0;
+     if (g_log_index_interval > 0 && !log_file->index_fp) {
+         log_file->index_fp = log_index_open(log_file->file_name, truncate, g_log_index_interval);
+     }
+ }
+
+ static void close_log_index(LogFile *log_file) {
+     if (log_file->index_fp) {
+         fclose(log_file->index_fp);
+         log_file->index_fp = NULL;
+     }
+ }
+
+ /**
+  * @brief Adds an index point for a line just written, if it is the first or every g_log_index_interval-th.
+  * @param offset Offset of the line in the log file.
+  */
+ static void index_log_line(LogFile *log_file, const LogEntry_T *entry, off_t offset) {
+     if (!log_file->index_fp) {
+         return;
+     }
+     if (log_file->lines_since_index == 0) {
+         // The time cache holds the second of the line just formatted on this thread
+         LogIndexPoint point = { entry->index, g_log_time_cache.log_time, (uint64_t)offset };
+         if (!log_index_write_point(log_file->index_fp, &point)) {
+             stream_print(stderr, "Log Error: Could not write the index of %s\n", log_file->file_name);
+             close_log_index(log_file);
+             return;
+         }
+     }
+     log_file->lines_since_index = (log_file->lines_since_index + 1) % g_log_index_interval;
+ }
+
  static bool open_log_file_if_needed(LogFile *log_file) {
      if (!log_file) {
          return false;
      }
 
-     if (log_file->fp != NULL) {
+     if (log_file_is_open(log_file)) {
          return true;  // File already open
      }
 
-     static int log_failure_count = 0;
-     static int directory_creation_failure_count = 0;
-
      // Prepare directory
      char directory_path[MAX_PATH_LEN];
      // Strip the directory path from the full file path
      strip_directory_path(log_file->file_name, directory_path, sizeof(directory_path));
-     create_log_directory(directory_path, &directory_creation_failure_count);
+     create_log_directory(directory_path, &log_file->directory_failures);
 
      // Open file
-     char* mode = g_purge_logs_on_restart ? "w" : "a";
-     FILE* fp = NULL;
-     PlatformErrorCode err = platform_fopen(&fp, log_file->file_name, mode);
-     
-     if (err != PLATFORM_ERROR_SUCCESS || fp == NULL) {
-         log_file->fp = NULL;
-         return handle_open_failure(log_file->file_name, &log_failure_count);
+     if (g_log_writer == LOG_WRITER_MMAP) {
+         if (!open_log_segment(log_file, g_purge_logs_on_restart)) {
+             return handle_open_failure(log_file->file_name, &log_file->open_failures);
+         }
+     } else {
+         char* mode = g_purge_logs_on_restart ? "w" : "a";
+         FILE* fp = NULL;
+         PlatformErrorCode err = platform_fopen(&fp, log_file->file_name, mode);
+
+         if (err != PLATFORM_ERROR_SUCCESS || fp == NULL) {
+             log_file->fp = NULL;
+             return handle_open_failure(log_file->file_name, &log_file->open_failures);
+         }
+
+         // Lines are already gathered into batches, so the stream needs no buffer of its own
+         setvbuf(fp, NULL, _IONBF, 0);
+         log_file->fp = fp;
+
+         // The one size query for this file; from here on the size is counted as lines are written
+         struct stat st;
+         log_file->bytes_written = (!g_purge_logs_on_restart && stat(log_file->file_name, &st) == 0) ? st.st_size : 0;
      }
 
      // Success path
-     log_file->fp = fp;
-     log_failure_count = 0;
+     log_file->opened_at = time(NULL);
+     log_file->open_failures = 0;
+     open_log_index(log_file, g_purge_logs_on_restart);
 
      if (!log_file->first_open) {
          stream_print(stdout, "Successfully opened log file: %s\n", log_file->file_name);
@@ -518,8 +1127,9 @@ static bool handle_rename_failure(const char* source_file, const char* dest_file
 
 static void generate_timestamp_suffix(char *buffer, size_t size) {
     time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(buffer, size, ".%Y%m%d_%H%M%S", t);
+    struct tm t;
+    platform_localtime(&now, &t);  // Workers may rotate at the same time
+    strftime(buffer, size, ".%Y%m%d_%H%M%S", &t);
 }
 
 static void generate_rotated_log_filename(const char* original_filename, char* rotated_log_filename, size_t size) {
@@ -542,16 +1152,30 @@ static void generate_rotated_log_filename(const char* original_filename, char* r
 }
 
  /**
-  * @brief Rotates the log file if it exceeds the configured size.
+  * @brief Rotates the log file if it exceeds the configured size or age.
+  *
+  * The size is the running count of bytes written since the file was opened,
+  * so no file system query is made per line.
   */
  static bool rotate_log_file_if_needed(LogFile *log_file) {
-     struct stat st;
-     if (stat(log_file->file_name, &st) != 0 || st.st_size < g_log_file_size) {
+     bool too_big = log_file->bytes_written >= g_log_file_size;
+     bool too_old = g_log_rotate_interval_s > 0 &&
+                    time(NULL) - log_file->opened_at >= g_log_rotate_interval_s;
+     if (!too_big && !too_old) {
          return true;  // No rotation needed
      }
 
-     // Close current file
-     if (log_file->fp != NULL) {
+     PlatformHighResTimestamp_T rotation_start;
+     platform_get_high_res_timestamp(&rotation_start);
+
+     // Close current file, after writing out what belongs in it
+     if (log_file->segment != NULL) {
+         if (!close_log_segment(log_file)) {
+             stream_print(stderr, "Failed to close log segment: %s\n", log_file->file_name);
+             return false;
+         }
+     } else if (log_file->fp != NULL) {
+         write_log_batch(&log_file->batch, log_file->fp);
          if (fclose(log_file->fp) != 0) {
              stream_print(stderr, "Failed to close log file: %s (errno: %d)\n", 
                          log_file->file_name, errno);
@@ -560,6 +1184,7 @@ static void generate_rotated_log_filename(const char* original_filename, char* r
          }
          log_file->fp = NULL;
      }
+     close_log_index(log_file);
 
      // Generate new filename and rotate
      char rotated_log_filename[MAX_PATH_LEN];
@@ -572,28 +1197,62 @@ static void generate_rotated_log_filename(const char* original_filename, char* r
          return handle_rename_failure(log_file->file_name, rotated_log_filename, errno);
      }
 
-     // Open new file
-     FILE* fp = NULL;
-     PlatformErrorCode err = platform_fopen(&fp, log_file->file_name, "a");
-     if (err != PLATFORM_ERROR_SUCCESS || fp == NULL) {
-         stream_print(stderr, "Failed to open new log file after rotation: %s\n", 
-                     log_file->file_name);
-         return false;
+     // The index goes with its file; one left behind would point into the new file
+     char index_name[MAX_PATH_LEN];
+     char rotated_index_name[MAX_PATH_LEN];
+     log_index_path(index_name, sizeof(index_name), log_file->file_name);
+     log_index_path(rotated_index_name, sizeof(rotated_index_name), rotated_log_filename);
+     if (rename(index_name, rotated_index_name) != 0) {
+         remove(index_name);
      }
 
-     log_file->fp = fp;
+     // Open new file
+     if (g_log_writer == LOG_WRITER_MMAP) {
+         if (!open_log_segment(log_file, false)) {
+             stream_print(stderr, "Failed to map new log segment after rotation: %s\n",
+                         log_file->file_name);
+             return false;
+         }
+     } else {
+         FILE* fp = NULL;
+         PlatformErrorCode err = platform_fopen(&fp, log_file->file_name, "a");
+         if (err != PLATFORM_ERROR_SUCCESS || fp == NULL) {
+             stream_print(stderr, "Failed to open new log file after rotation: %s\n", 
+                         log_file->file_name);
+             return false;
+         }
+
+         setvbuf(fp, NULL, _IONBF, 0);
+         log_file->fp = fp;
+     }
+     log_file->bytes_written = 0;
+     log_file->opened_at = time(NULL);
+     log_file->rotations++;
+     open_log_index(log_file, true);
+
+     PlatformHighResTimestamp_T rotation_end;
+     uint64_t rotation_ns = 0;
+     platform_get_high_res_timestamp(&rotation_end);
+     platform_timestamp_elapsed(&rotation_start, &rotation_end, PLATFORM_TIME_GRANULARITY_NS, &rotation_ns);
+     logger_metrics_record_rotation(rotation_ns);
+
+     // Pruning old rotations is left to the maintenance thread, see drain_log_queue
+     log_file->maintenance_pending = true;
+     g_log_workers[log_file_worker(log_file)].maintenance_pending = true;
      return true;
  }
  
  /**
-  * @brief Convert a log destination string to the corresponding LogOutput enum.
-  * @param destination_str The string representing the log destination.
-  * @param default_output The default log output if the string is invalid.
-  * @return The corresponding LogOutput value.
+  * @brief Convert one log destination name to the corresponding LogOutput flags.
+  * @return The flags, or 0 if the name is not recognised.
   */
- LogOutput log_output_from_string(const char* destination_str, LogOutput default_output) {
-     if (!destination_str) return default_output;
- 
+ static LogOutput log_output_from_name(const char* destination_str) {
+     if (strcmp_nocase(destination_str, "network") == 0 ||
+         strcmp_nocase(destination_str, "udp") == 0 ||
+         strcmp_nocase(destination_str, "tcp") == 0) {
+         return LOG_OUTPUT_NETWORK;
+     }
+
      /* Normalize input for case-insensitive comparison */
      if (strcmp_nocase(destination_str, "file") == 0 ||
          strcmp_nocase(destination_str, "log_file") == 0) {
@@ -614,20 +1273,96 @@ static void generate_rotated_log_filename(const char* original_filename, char* r
          strcmp_nocase(destination_str, "all") == 0) {
          return LOG_OUTPUT_BOTH;
      }
- 
-     /* Return the default output if the string is unrecognized */
-     return default_output;
+
+     return (LogOutput)0;
+ }
+
+ /**
+  * @brief Convert a log destination string to the corresponding LogOutput flags.
+  * @param destination_str One destination, or several separated by commas, e.g. "both,network".
+  * @param default_output The default log output if the string is invalid.
+  * @return The corresponding LogOutput value.
+  */
+ LogOutput log_output_from_string(const char* destination_str, LogOutput default_output) {
+     if (!destination_str) return default_output;
+
+     char names[MAX_PATH_LEN];
+     names[0] = '\0';
+     platform_strcat(names, destination_str, sizeof(names));
+
+     unsigned int output = 0;
+     char* next = names;
+     while (next) {
+         char* name = next;
+         next = strchr(name, ',');
+         if (next) {
+             *next++ = '\0';
+         }
+         while (*name == ' ') name++;
+         for (char* end = name + strlen(name); end > name && end[-1] == ' '; end--) {
+             end[-1] = '\0';
+         }
+
+         LogOutput flags = log_output_from_name(name);
+         if (!flags) {
+             /* Return the default output if any name is unrecognized */
+             return default_output;
+         }
+         output |= flags;
+     }
+     return (LogOutput)output;
  }
  
  
+ /**
+  * @brief Gets the message text of a log entry, rendering it if formatting was deferred.
+  * @param entry The log entry.
+  * @param buffer Scratch buffer for the rendered text.
+  * @param size The size of the scratch buffer.
+  * @return The message text.
+  */
+ static const char* get_log_entry_message(const LogEntry_T* entry, char* buffer, size_t size) {
+     if (!entry->format) {
+         return entry->message;
+     }
+     if (log_deferred_render(buffer, size, entry->format,
+                             (const uint8_t*)entry->message, entry->args_size) < 0) {
+         snprintf(buffer, size, "Log Error: Malformed deferred log entry for format \"%s\"", entry->format);
+     }
+     return buffer;
+ }
+
+ /**
+  * @brief Gets the worker that writes the log file of a route.
+  */
+ static uint32_t route_worker(uint16_t route) {
+     const LogFile* log_file = (route <= MAX_THREADS) ? thread_log_files[route].log_file : NULL;
+     return log_file ? log_file_worker(log_file) : 0;
+ }
+
  /**
   * @brief Logs a message immediately to file and console.
   * @param level The log level of the message.
   * @param entry The formatted log message.
   */
 void log_immediately(const LogEntry_T* entry) {
-    // mutex will have been aquired by the caller
-     if (!entry || entry->message[0] == '\0') {
+    // The mutex of the worker that owns the entry's log file will have been acquired by the caller
+
+     // Entries the thread dropped on overflow are reported where they would have been
+     if (entry && entry->dropped > 0) {
+         LogEntry_T notice = *entry;
+         notice.level = LOG_WARN;
+         notice.format = NULL;
+         notice.dropped = 0;
+         snprintf(notice.message, sizeof(notice.message),
+                  "%u log entries dropped (log queue overflow)", (unsigned)entry->dropped);
+         log_immediately(&notice);
+     }
+
+     char render_buffer[LOG_MSG_BUFFER_SIZE];
+     const char* message = entry ? get_log_entry_message(entry, render_buffer, sizeof(render_buffer)) : NULL;
+
+     if (!message || message[0] == '\0') {
          char error_buffer[LOG_MSG_BUFFER_SIZE];
          size_t written = (size_t)snprintf(error_buffer, sizeof(error_buffer), 
              "Log Error: Attempted to log NULL or blank message\n");
@@ -637,9 +1372,8 @@ void log_immediately(const LogEntry_T* entry) {
          return;
      }
 
-     const char* thread_label = entry && entry->thread_label[0] != '\0' ? 
-                               entry->thread_label : get_thread_label();
-     ThreadLogFile* tlf = &thread_log_files[APP_LOG_FILE_INDEX];
+     /* The entry's thread may have a specific log file, resolved when the entry was created */
+     ThreadLogFile* tlf = &thread_log_files[entry->route <= MAX_THREADS ? entry->route : APP_LOG_FILE_INDEX];
 
      bool can_log_to_file = true;
      LogOutput current_output = g_log_output;  // Use a temporary variable
@@ -647,46 +1381,60 @@ void log_immediately(const LogEntry_T* entry) {
      /* Check if we have a valid LogFile before attempting file operations */
      if (!tlf->log_file || !tlf->log_file->file_name[0]) {
          can_log_to_file = false;
-         current_output = LOG_OUTPUT_SCREEN;  // Temporary fallback to screen logging
+         current_output |= LOG_OUTPUT_SCREEN;  // Temporary fallback to screen logging
      } else {
-         /* Rotate & open the main log file if needed */
-         if (tlf->log_file->fp) {
+         /* Rotate & open the log file if needed */
+         if (log_file_is_open(tlf->log_file)) {
              if (!rotate_log_file_if_needed(tlf->log_file)) {
                  can_log_to_file = false;
-                 current_output = LOG_OUTPUT_SCREEN;  // Fallback to screen logging
+                 current_output |= LOG_OUTPUT_SCREEN;  // Fallback to screen logging
              }
          }
          if (!open_log_file_if_needed(tlf->log_file)) {
              can_log_to_file = false;
-             current_output = LOG_OUTPUT_SCREEN;  // Fallback to screen logging
+             current_output |= LOG_OUTPUT_SCREEN;  // Fallback to screen logging
          }
+     }
 
-         /* Check if the current thread has a specific log file */
-         for (int i = 1; i < g_thread_log_file_count; i++) {
-             if (thread_label && strcmp_nocase(thread_log_files[i].thread_label, thread_label) == 0) {
-                 if (thread_log_files[i].log_file->fp) {
-                     if (!rotate_log_file_if_needed(thread_log_files[i].log_file)) {
-                         stream_print(stderr, "File Error: Could not rotate log file for thread %s\n", thread_label);
-                     }
-                 }
-                 if (!open_log_file_if_needed(thread_log_files[i].log_file)) {
-                     stream_print(stderr, "File Error: Could not open log file for thread %s\n", thread_label);
-                 }
-                 tlf = &thread_log_files[i];
-                 break;
-             }
+     /* Log to file if enabled and filename is valid */
+     if (can_log_to_file && (current_output & LOG_OUTPUT_FILE)) {
+         off_t offset = tlf->log_file->bytes_written;
+         size_t written = publish_log_entry(entry, message, tlf->log_file->fp, &tlf->log_file->batch);
+         if (written > 0) {
+             index_log_line(tlf->log_file, entry, offset);
          }
+         tlf->log_file->bytes_written += (off_t)written;
+         tlf->log_file->total_bytes += written;
      }
 
-     /* Log to file if enabled and filename is valid */
-     if (can_log_to_file && (current_output == LOG_OUTPUT_FILE || current_output == LOG_OUTPUT_BOTH)) {
-         publish_log_entry(entry, tlf->log_file->fp);
+     /* Screen and network output are shared by all workers */
+     if (!(current_output & (LOG_OUTPUT_SCREEN | LOG_OUTPUT_NETWORK))) {
+         return;
      }
+     lock_mutex(&logging_mutex);
 
-     /* Log to screen if enabled */
-     if (!console_logging_suspended && (current_output == LOG_OUTPUT_SCREEN || current_output == LOG_OUTPUT_BOTH)) {
-         publish_log_entry(entry, stderr);
+     /* Log to screen if enabled; while the console sink runs, a full ring drops the line rather than wait */
+     if (current_output & LOG_OUTPUT_SCREEN) {
+         if (g_console_ring) {
+             char line[LOG_LINE_BUFFER_SIZE];
+             size_t length = format_log_line(entry, message, g_log_use_ansi_colours, line, sizeof(line));
+             if (length > 0) {
+                 log_line_ring_push(g_console_ring, line, length);
+             }
+         } else {
+             publish_log_entry(entry, message, stderr, &g_console_batch);
+         }
      }
+
+     /* Hand to the network sink if enabled; it never blocks */
+     if (current_output & LOG_OUTPUT_NETWORK) {
+         char line[LOG_LINE_BUFFER_SIZE];
+         size_t length = format_output_line(entry, message, line, sizeof(line));
+         if (length > 0) {
+             log_network_enqueue(line, length);
+         }
+     }
+     unlock_mutex(&logging_mutex);
  }
  
  
@@ -694,9 +1442,12 @@ void log_immediately(const LogEntry_T* entry) {
   * @brief Logs a message avoiding the queue
   */
  void log_now(const LogEntry_T *entry) {
-     lock_mutex(&logging_mutex);
+     uint32_t worker = entry ? route_worker(entry->route) : 0;
+     lock_mutex(&g_log_workers[worker].mutex);
      log_immediately(entry);
-     unlock_mutex(&logging_mutex);
+     // Direct logging bypasses the logger workers, so nothing would write this out later
+     write_all_log_batches(worker);
+     unlock_mutex(&g_log_workers[worker].mutex);
  }
  
  unsigned long long safe_increment_index(void) {
@@ -705,44 +1456,211 @@ void log_immediately(const LogEntry_T* entry) {
      return platform_atomic_fetch_add_uint64(&log_index, 1) + 1;
  }
  
- void create_log_entry(LogEntry_T* entry, LogLevel level, const char* message) {
-     const char* this_thread_label = get_thread_label();
-     const char* name = this_thread_label ? this_thread_label : "UNKNOWN";
+ uint16_t logger_intern_label(const char* label) {
+     if (!label) {
+         return 0;
+     }
+
+     lock_mutex(&label_mutex);
+     uint32_t count = platform_atomic_load_uint32(&g_log_label_count);
+     uint16_t label_id = 0;
+     bool found = false;
+     for (uint32_t i = 0; i < count && !found; i++) {
+         if (strncmp(g_log_labels[i], label, THREAD_LABEL_SIZE - 1) == 0) {
+             label_id = (uint16_t)i;
+             found = true;
+         }
+     }
+     if (!found && count < MAX_LOG_LABELS) {
+         // Fill the slot before publishing the new count to readers
+         g_log_labels[count][0] = '\0';
+         platform_strcat(g_log_labels[count], label, sizeof(g_log_labels[count]));
+         platform_atomic_store_uint32(&g_log_label_count, count + 1);
+         label_id = (uint16_t)count;
+         log_flight_recorder_label(label_id, g_log_labels[count]);
+     }
+     unlock_mutex(&label_mutex);
+
+     return label_id;
+ }
+
+ const char* logger_label_name(uint16_t label_id) {
+     if (label_id >= platform_atomic_load_uint32(&g_log_label_count)) {
+         return g_log_labels[0];
+     }
+     return g_log_labels[label_id];
+ }
 
+ /**
+  * @brief Gets the label id of the calling thread, interning its label on first use.
+  */
+ static uint16_t get_thread_label_id(void) {
+     static THREAD_LOCAL const char* cached_label = NULL;
+     static THREAD_LOCAL uint16_t cached_label_id = 0;
+
+     const char* label = get_thread_label();
+     if (label != cached_label) {
+         cached_label_id = logger_intern_label(label);
+         cached_label = label;
+     }
+     return cached_label_id;
+ }
+
+ bool logger_level_enabled(LogLevel level) {
+     static THREAD_LOCAL uint32_t cached_generation = 0;
+     static THREAD_LOCAL const char* cached_label = NULL;
+     static THREAD_LOCAL LogLevel cached_level = LOG_TRACE;
+
+     uint32_t generation = platform_atomic_load_uint32(&g_log_level_generation);
+     const char* label = get_thread_label();
+     if (generation != cached_generation || label != cached_label) {
+         uint8_t label_level = g_label_log_levels[get_thread_label_id()];
+         cached_level = label_level ? (LogLevel)(label_level - 1) : g_log_level;
+         cached_generation = generation;
+         cached_label = label;
+     }
+     return level >= cached_level;
+ }
+
+ /**
+  * @brief Fills in the index, timestamp, level and thread label of a new entry.
+  */
+ static void init_log_entry_header(LogEntry_T* entry, LogLevel level) {
      entry->index = safe_increment_index();
      // Use platform-agnostic timestamp function
      platform_get_high_res_timestamp(&entry->timestamp);
      entry->level = level;
-     
-     // Initialize strings to empty first
-     entry->thread_label[0] = '\0';
+     entry->format = NULL;
+     entry->args_size = 0;
+     entry->label_id = get_thread_label_id();
+     entry->route = platform_atomic_load_uint8(&g_label_log_routes[entry->label_id]);
+     entry->dropped = 0;
+ }
+
+ void create_log_entry(LogEntry_T* entry, LogLevel level, const char* message) {
+     init_log_entry_header(entry, level);
      entry->message[0] = '\0';
-     
-     // Copy the thread label and message safely using platform_strcat
-     platform_strcat(entry->thread_label, name, sizeof(entry->thread_label));
      platform_strcat(entry->message, message, sizeof(entry->message));
+     log_flight_recorder_record(entry);
  }
  
  
+ // Rate-limited sites of this thread that have held entries back since they were last reported
+ static THREAD_LOCAL LogRateLimit* thread_limited_sites = NULL;
+ static THREAD_LOCAL bool thread_flushing_sites = false;
+
+ /**
+  * @brief Reports and unlists the calling thread's limited sites, all of them or those gone quiet.
+  */
+ static void flush_limited_sites(bool all, uint32_t now) {
+     if (thread_flushing_sites) {
+         return;  // The summaries below come back through _logger_log
+     }
+     thread_flushing_sites = true;
+
+     LogRateLimit* site = thread_limited_sites;
+     thread_limited_sites = NULL;
+     while (site) {
+         LogRateLimit* next = site->next_listed;
+         if (!all && site->suppressed && now - site->last_ticks < g_log_rate_limit_interval_ms) {
+             // Still busy; its count goes out with the next entry it lets through
+             site->next_listed = thread_limited_sites;
+             thread_limited_sites = site;
+         } else {
+             if (site->suppressed && LOGGER_LEVEL_ENABLED(site->level)) {
+                 _logger_log(site->level, "[%s:%d] %u similar messages suppressed",
+                             site->file, site->line, site->suppressed);
+             }
+             site->suppressed = 0;
+             site->listed = false;
+         }
+         site = next;
+     }
+     thread_flushing_sites = false;
+ }
+
+ /**
+  * @copydoc logger_rate_limit_flush
+  */
+ void logger_rate_limit_flush(void) {
+     if (thread_limited_sites) {
+         flush_limited_sites(true, 0);
+     }
+ }
+
+ /**
+  * @copydoc logger_rate_limit_allow
+  */
+ bool logger_rate_limit_allow(LogRateLimit* site, LogLevel level, const char* file, int line, uint32_t* repeats) {
+     uint32_t capacity = g_log_rate_limit_interval_ms * g_log_rate_limit_burst;
+     uint32_t now;
+     platform_get_tick_count(&now);
+
+     if (!site->started) {
+         site->credit_ms = capacity;
+         site->started = true;
+     } else {
+         uint32_t elapsed = now - site->last_ticks;
+         site->credit_ms = (elapsed >= capacity - site->credit_ms) ? capacity : site->credit_ms + elapsed;
+     }
+     site->last_ticks = now;
+
+     if (site->credit_ms < g_log_rate_limit_interval_ms) {
+         site->suppressed++;
+         if (!site->listed) {
+             site->level = level;
+             site->file = file;
+             site->line = line;
+             site->listed = true;
+             site->next_listed = thread_limited_sites;
+             thread_limited_sites = site;
+         }
+         return false;
+     }
+     site->credit_ms -= g_log_rate_limit_interval_ms;
+     *repeats = site->suppressed;
+     site->suppressed = 0;
+     return true;
+ }
+
  void _logger_log(LogLevel level, const char* format, ...) {
-     if (level < g_log_level) {
-         return;
+     // Sites that have gone quiet since holding entries back report them now
+     if (thread_limited_sites) {
+         uint32_t now;
+         platform_get_tick_count(&now);
+         flush_limited_sites(false, now);
      }
- 
+
+     LogEntry_T entry;
+     init_log_entry_header(&entry, level);
+
      va_list args;
      va_start(args, format);
- 
-     // Format the log message
-     char log_buffer[LOG_MSG_BUFFER_SIZE];
-     vsnprintf(log_buffer, sizeof(log_buffer), format, args);
+
+     // Capture the raw arguments if possible, leaving formatting to the logger thread
+     int captured = -1;
+     if (g_deferred_formatting) {
+         va_list capture_args;
+         va_copy(capture_args, args);
+         captured = log_deferred_capture(format, capture_args,
+                                         (uint8_t*)entry.message, sizeof(entry.message));
+         va_end(capture_args);
+     }
+
+     if (captured >= 0) {
+         entry.format = format;
+         entry.args_size = (uint16_t)captured;
+     } else {
+         // Format the log message directly into the entry
+         vsnprintf(entry.message, sizeof(entry.message), format, args);
+     }
      va_end(args);
- 
-     LogEntry_T entry;
-     create_log_entry(&entry, level, log_buffer);
+     log_flight_recorder_record(&entry);
  
      if (logging_thread_started) {
-         // Push the log message to the queue; if full, log immediately
-         if (!log_queue_push(&global_log_queue, &entry)) {
+         // Push the log message to this thread's ring; if none is free, log immediately.
+         // A full ring is dealt with by the overflow policy, never by logging from this thread.
+         if (log_queue_push(&global_log_queue, &entry, route_worker(entry.route)) == LOG_PUSH_NO_RING) {
              log_now(&entry);
          }
      } else {
@@ -763,13 +1681,42 @@ void log_immediately(const LogEntry_T* entry) {
 
      g_purge_logs_on_restart = get_config_bool("logger", "purge_logs_on_restart", g_purge_logs_on_restart);
 
+     /* Read the flush policy */
+     const char* config_log_flush = get_config_string("logger", "log_flush", NULL);
+     g_log_flush = log_flush_policy_from_string(config_log_flush, g_log_flush);
+     g_log_flush_interval_ms = (uint32_t)get_config_int("logger", "log_flush_interval_ms", (int)g_log_flush_interval_ms);
+
+     /* Read how sparse the index kept beside each log file is */
+     int index_interval = get_config_int("logger", "log_index_interval", (int)g_log_index_interval);
+     g_log_index_interval = (uint32_t)(index_interval > 0 ? index_interval : 0);
+
+     /* Read how log files are written */
+     const char* config_log_writer = get_config_string("logger", "log_writer", NULL);
+     g_log_writer = log_writer_from_string(config_log_writer, g_log_writer);
+
+     /* Read the format of log file and network lines */
+     const char* config_log_format = get_config_string("logger", "log_format", NULL);
+     g_log_format = log_format_from_string(config_log_format, g_log_format);
+
+     /* Read whether formatting is deferred to the logger thread */
+     g_deferred_formatting = get_config_bool("logger", "deferred_formatting", g_deferred_formatting);
+
      /* Read log destination */
      const char* config_log_destination = get_config_string("logger", "log_destination", NULL);
      g_log_output = log_output_from_string(config_log_destination, LOG_OUTPUT_SCREEN);
+     if ((g_log_output & LOG_OUTPUT_NETWORK) && !log_network_init()) {
+         stream_print(stderr, "Log Error: Could not set up the network log sink\n");
+         g_log_output &= ~LOG_OUTPUT_NETWORK;
+     }
 
      /* Read timestamp granularity */
      const char* config_timestamp_granularity = get_config_string("logger", "timestamp_granularity", NULL);
      g_log_timestamp_granularity = timestamp_granularity_from_string(config_timestamp_granularity, LOG_TS_NANOSECOND);
+     g_log_fraction_divisor = 1000000000u / (uint32_t)g_log_timestamp_granularity;
+     g_log_fraction_width = 0;
+     for (uint32_t units = (uint32_t)g_log_timestamp_granularity; units >= 10; units /= 10) {
+         g_log_fraction_width++;
+     }
 
      /* Read ANSI colour setting */
      g_log_use_ansi_colours = get_config_bool("logger", "ansi_colours", g_log_use_ansi_colours);
@@ -780,6 +1727,19 @@ void log_immediately(const LogEntry_T* entry) {
      /* Read log file size */
      g_log_file_size = get_config_int("logger", "log_file_size", g_log_file_size);
 
+     /* Read log rotation interval */
+     const char* config_log_rotate_interval = get_config_string("logger", "log_rotate_interval", NULL);
+     g_log_rotate_interval_s = log_rotate_interval_from_string(config_log_rotate_interval, g_log_rotate_interval_s);
+
+     /* Read the rate of rate-limited log sites */
+     int rate_per_minute = get_config_int("logger", "log_rate_limit_per_minute", 60000 / (int)g_log_rate_limit_interval_ms);
+     g_log_rate_limit_interval_ms = 60000u / (uint32_t)(rate_per_minute > 0 ? rate_per_minute : 1);
+     int rate_burst = get_config_int("logger", "log_rate_limit_burst", (int)g_log_rate_limit_burst);
+     g_log_rate_limit_burst = (uint32_t)(rate_burst > 0 ? rate_burst : 1);
+
+     /* Read the period of the metrics summary line */
+     g_log_metrics_interval_s = (uint32_t)get_config_int("logger", "log_metrics_interval_s", (int)g_log_metrics_interval_s);
+
      /* Read log file path and name */
      const char* config_log_file_path = get_config_string("logger", CONFIG_LOG_PATH_KEY, NULL);
      const char* config_log_file_name = get_config_string("logger", CONFIG_LOG_FILE_KEY, NULL);
@@ -815,6 +1775,7 @@ void log_immediately(const LogEntry_T* entry) {
 
          sanitise_path(main_log->file_name);
          main_log->fp = NULL;
+         main_log->segment = NULL;
          main_log->first_open = false;
 
          /* Set up the main ThreadLogFile to point to this LogFile */
@@ -822,9 +1783,37 @@ void log_immediately(const LogEntry_T* entry) {
          thread_log_files[APP_LOG_FILE_INDEX].thread_label[0] = '\0';  // Main log has no specific thread
      }
 
+     /* Open the flight recorder, and give it the labels interned so far */
+     const char* config_flight_recorder = get_config_string("logger", "log_flight_recorder", NULL);
+     uint64_t flight_recorder_size = (uint64_t)get_config_int("logger", "log_flight_recorder_size", 4194304);
+     if (config_flight_recorder && *config_flight_recorder) {
+         if (log_flight_recorder_open(config_flight_recorder, flight_recorder_size)) {
+             lock_mutex(&label_mutex);
+             uint32_t label_count = platform_atomic_load_uint32(&g_log_label_count);
+             for (uint32_t i = 0; i < label_count; i++) {
+                 log_flight_recorder_label((uint16_t)i, g_log_labels[i]);
+             }
+             unlock_mutex(&label_mutex);
+         } else {
+             stream_print(stderr, "Log Error: Could not open the flight recorder %s\n", config_flight_recorder);
+         }
+     }
+
+     /* Read how many threads write the log files, each its own share of them */
+     int worker_count = get_config_int("logger", "log_worker_threads", (int)g_log_worker_count);
+     g_log_worker_count = (uint32_t)(worker_count < 1 ? 1 : worker_count > LOG_MAX_WORKERS ? LOG_MAX_WORKERS : worker_count);
+
      /* Initialize log queue */
      log_queue_init(&global_log_queue);
 
+     /* Read what producers do when their ring is full */
+     const char* config_log_overflow = get_config_string("logger", "log_overflow", NULL);
+     const char* config_log_overflow_level = get_config_string("logger", "log_overflow_level", NULL);
+     log_queue_set_overflow_policy(&global_log_queue,
+         log_overflow_policy_from_string(config_log_overflow, global_log_queue.overflow_policy),
+         log_level_from_string(config_log_overflow_level, global_log_queue.overflow_level),
+         (uint32_t)get_config_int("logger", "log_overflow_sample_rate", (int)global_log_queue.sample_rate));
+
      /* Start logging thread regardless of success */
      logging_thread_started = true;
 
@@ -848,6 +1837,16 @@ void log_immediately(const LogEntry_T* entry) {
   */
  void logger_set_level(LogLevel level) {
      g_log_level = level;
+     platform_atomic_fetch_add_uint32(&g_log_level_generation, 1);
+ }
+
+ /**
+  * @brief Sets the log level of the threads with a label.
+  * @param label The thread label.
+  * @param level The log level to set.
+  */
+ void logger_set_label_level(const char* label, LogLevel level) {
+     set_label_level(logger_intern_label(label), level);
  }
  
  /**
@@ -862,16 +1861,34 @@ void log_immediately(const LogEntry_T* entry) {
   * @brief Closes the logger and releases resources.
   */
  void logger_close(void) {
-     lock_mutex(&logging_mutex);
-     // Close all unique log files
-     for (int i = 0; i < g_log_file_count; i++) {
-         if (log_files[i].fp) {
-             fclose(log_files[i].fp);
-             log_files[i].fp = NULL;
+     // Close all unique log files, each under the mutex of the worker that writes it
+     int count = get_log_file_count();
+     for (uint32_t worker = 0; worker < g_log_worker_count; worker++) {
+         lock_mutex(&g_log_workers[worker].mutex);
+         write_all_log_batches(worker);
+         for (int i = (int)worker; i < count; i += (int)g_log_worker_count) {
+             if (log_files[i].fp) {
+                 fclose(log_files[i].fp);
+                 log_files[i].fp = NULL;
+             }
+             if (log_files[i].segment) {
+                 close_log_segment(&log_files[i]);
+             }
+             close_log_index(&log_files[i]);
          }
+         unlock_mutex(&g_log_workers[worker].mutex);
      }
+
+     log_flight_recorder_mark_closed();
+
+     lock_mutex(&logging_mutex);
      g_log_file_count = 0;
      g_thread_log_file_count = 0;  // Reset thread counter for completeness
+     for (int i = 0; i < MAX_LOG_LABELS; i++) {
+         platform_atomic_store_uint8(&g_label_log_routes[i], APP_LOG_FILE_INDEX);
+     }
+     memset(g_label_log_levels, 0, sizeof(g_label_log_levels));
+     platform_atomic_fetch_add_uint32(&g_log_level_generation, 1);
 
      unlock_mutex(&logging_mutex);
 
@@ -889,33 +1906,218 @@ void log_immediately(const LogEntry_T* entry) {
      return log_level_to_string(level);
  }
 
-static void* logger_thread_function(void* arg) {
-    // printf("Logger thread started\n");
-    (void)arg;
-    logger_log(LOG_INFO, "Logger thread started");
+/**
+ * @brief Hands each of a worker's rotated log files to the maintenance thread.
+ *
+ * The request is queued without the worker's mutex held, as the thread
+ * registry takes locks of its own and may itself log.
+ */
+static void request_log_maintenance(uint32_t worker) {
+    LogWorker* log_worker = &g_log_workers[worker];
+
+    for (;;) {
+        char file_name[MAX_PATH_LEN] = "";
+
+        int count = get_log_file_count();
+        lock_mutex(&log_worker->mutex);
+        for (int i = (int)worker; i < count && !file_name[0]; i += (int)g_log_worker_count) {
+            if (log_files[i].maintenance_pending) {
+                log_files[i].maintenance_pending = false;
+                platform_strcat(file_name, log_files[i].file_name, sizeof(file_name));
+            }
+        }
+        if (!file_name[0]) {
+            log_worker->maintenance_pending = false;
+        }
+        unlock_mutex(&log_worker->mutex);
 
-    // No more condition/flag needed - thread registry state is enough
+        if (!file_name[0]) {
+            return;
+        }
+        // Without the maintenance thread, old rotations are simply kept
+        log_maintenance_request(file_name);
+    }
+}
+
+/**
+ * @brief Writes out a batch of a worker's queued entries under a single hold of its mutex.
+ * @param worker The worker, whose log files no other worker writes.
+ * @return The number of entries written.
+ */
+static int drain_log_queue(uint32_t worker) {
+    LogWorker* log_worker = &g_log_workers[worker];
     LogEntry_T entry;
- 
+    int drained = 0;
+    PlatformHighResTimestamp_T start, end;
+
+    platform_get_high_res_timestamp(&start);
+    lock_mutex(&log_worker->mutex);
+    while (drained < LOGGER_BATCH_SIZE && log_queue_pop(&global_log_queue, worker, &entry)) {
+        log_immediately(&entry);
+        drained++;
+    }
+    flush_log_batches_if_due(worker, true);
+    bool maintenance_pending = log_worker->maintenance_pending;
+    unlock_mutex(&log_worker->mutex);
+
+    if (drained > 0) {
+        uint64_t elapsed_ns = 0;
+        platform_get_high_res_timestamp(&end);
+        platform_timestamp_elapsed(&start, &end, PLATFORM_TIME_GRANULARITY_NS, &elapsed_ns);
+        logger_metrics_record_drain((uint32_t)drained, elapsed_ns);
+    }
+    if (maintenance_pending) {
+        request_log_maintenance(worker);
+    }
+    return drained;
+}
+
+/**
+ * @copydoc logger_get_file_metrics
+ */
+int logger_get_file_metrics(LogFileMetrics* files, int max_files) {
+    int count = get_log_file_count();
+    if (count > max_files) {
+        count = max_files;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const char* name = strrchr(log_files[i].file_name, PATH_SEPARATOR);
+        name = name ? name + 1 : log_files[i].file_name;
+        files[i].file_name[0] = '\0';
+        platform_strcat(files[i].file_name, name, sizeof(files[i].file_name));
+
+        // The counters move under the mutex of the worker that writes the file
+        PlatformMutex_T* mutex = &g_log_workers[log_file_worker(&log_files[i])].mutex;
+        lock_mutex(mutex);
+        files[i].bytes_written = log_files[i].total_bytes;
+        files[i].rotations = log_files[i].rotations;
+        unlock_mutex(mutex);
+    }
+    return count;
+}
+
+/**
+ * @copydoc logger_attach_console_ring
+ */
+void logger_attach_console_ring(LogLineRing* ring) {
+    lock_mutex(&logging_mutex);
+    // Lines already gathered for stderr go out first, so the screen keeps its order
+    write_log_batch(&g_console_batch, stderr);
+    g_console_ring = ring;
+    unlock_mutex(&logging_mutex);
+}
+
+/**
+ * @brief Logs a metrics summary line when the configured period has passed.
+ *
+ * Rates in the line are measured over the period since the previous one.
+ */
+static void log_metrics_summary_if_due(void) {
+    static LoggerMetrics previous;
+    static uint32_t previous_ticks;
+    static bool started = false;
+
+    if (g_log_metrics_interval_s == 0) {
+        return;
+    }
+
+    uint32_t now_ticks;
+    platform_get_tick_count(&now_ticks);
+    if (!started) {
+        logger_metrics_get(&previous);
+        previous_ticks = now_ticks;
+        started = true;
+        return;
+    }
+    uint32_t elapsed_ms = now_ticks - previous_ticks;
+    if (elapsed_ms < g_log_metrics_interval_s * 1000u) {
+        return;
+    }
+
+    LoggerMetrics current;
+    char summary[LOG_MSG_BUFFER_SIZE];
+    logger_metrics_get(&current);
+    logger_metrics_format_summary(&current, &previous, elapsed_ms, summary, sizeof(summary));
+    logger_log(LOG_INFO, "%s", summary);
+    previous = current;
+    previous_ticks = now_ticks;
+}
+
+/**
+ * @brief Writes out a worker's entries until shutdown, parking when there are none.
+ * @param worker The worker; worker 0, the LOGGER thread, also stands in for workers not running.
+ */
+static void run_log_worker(uint32_t worker) {
+    int idle_polls = 0;
+
     while (!shutdown_signalled()) {
-        while (log_queue_pop(&global_log_queue, &entry)) {
-            if (*entry.thread_label == '\0')
-               printf("Logger thread processing log from: NULL\n");
-            log_now(&entry);
+        int drained = 0;
+        if (worker == 0) {
+            log_metrics_summary_if_due();
+            for (uint32_t other = 1; other < g_log_worker_count; other++) {
+                if (!log_queue_worker_running(&global_log_queue, other)) {
+                    drained += drain_log_queue(other);
+                }
+            }
+        }
+        drained += drain_log_queue(worker);
+        if (drained > 0) {
+            idle_polls = 0;
+            continue;
+        }
+        // Spin briefly so bursts are picked up at once, then park until a producer signals
+        if (++idle_polls >= LOGGER_SPIN_LIMIT) {
+            // With an interval flush policy, wake in time to write out held-back lines
+            uint32_t park_ms = (g_log_flush == LOG_FLUSH_INTERVAL && g_log_flush_interval_ms < LOGGER_PARK_TIMEOUT_MS)
+                ? g_log_flush_interval_ms : LOGGER_PARK_TIMEOUT_MS;
+            log_queue_wait(&global_log_queue, worker, park_ms);
+            idle_polls = 0;
         }
-        // sleep_ms(1);
     }
+}
+
+static void* logger_thread_function(void* arg) {
+    // printf("Logger thread started\n");
+    (void)arg;
+    log_queue_set_consumer_thread();
+    logger_log(LOG_INFO, "Logger thread started, %u log writer%s", g_log_worker_count,
+               g_log_worker_count == 1 ? "" : "s");
+
+    // No more condition/flag needed - thread registry state is enough
+    run_log_worker(0);
 
     PlatformWaitResult wait_result = thread_registry_wait_others();
     if (wait_result != PLATFORM_WAIT_SUCCESS) {
         logger_log(LOG_WARN, "Logger thread failed to wait for other threads: %d", wait_result);
     }
     
+    // Write out whatever the other threads, the other workers included, logged on their way out
+    for (uint32_t worker = 0; worker < g_log_worker_count; worker++) {
+        while (drain_log_queue(worker) > 0) {
+        }
+    }
+
     logger_log(LOG_INFO, "Logger thread shutting down.");
     stream_print(stdout, "Logger thread bye bye.\n");
     return (void*)THREAD_SUCCESS;
 }
 
+static void* logger_worker_function(void* arg) {
+    uint32_t worker = (uint32_t)(uintptr_t)((ThreadConfig*)arg)->data;
+
+    log_queue_set_consumer_thread();
+    log_queue_set_worker_running(&global_log_queue, worker, true);
+    logger_log(LOG_INFO, "Logger worker %u started", worker);
+
+    run_log_worker(worker);
+
+    // From here the LOGGER thread writes out the worker's entries
+    log_queue_set_worker_running(&global_log_queue, worker, false);
+    logger_log(LOG_INFO, "Logger worker %u shutting down", worker);
+    return (void*)THREAD_SUCCESS;
+}
+
 static ThreadConfig logger_thread;
 
 ThreadConfig* get_logger_thread(void) {
@@ -929,3 +2131,24 @@ ThreadConfig* get_logger_thread(void) {
     }
     return &logger_thread;
 }
+
+uint32_t logger_worker_count(void) {
+    return g_log_worker_count;
+}
+
+ThreadConfig* get_logger_worker_thread(uint32_t worker) {
+    static ThreadConfig worker_threads[LOG_MAX_WORKERS];
+    static char worker_labels[LOG_MAX_WORKERS][THREAD_LABEL_SIZE];
+
+    if (worker == 0 || worker >= g_log_worker_count) {
+        return NULL;
+    }
+    if (!worker_threads[worker].label) {
+        snprintf(worker_labels[worker], sizeof(worker_labels[worker]), "LOGGER.%u", worker);
+        worker_threads[worker] = ThreadConfigTemplate;
+        worker_threads[worker].label = worker_labels[worker];
+        worker_threads[worker].func = logger_worker_function;
+        worker_threads[worker].data = (void*)(uintptr_t)worker;
+    }
+    return &worker_threads[worker];
+}
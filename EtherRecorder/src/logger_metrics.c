@@ -0,0 +1,173 @@
+/**
+ * @file logger_metrics.c
+ * @brief Self-metrics of the logger.
+ */
+
+#include "logger_metrics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log_queue.h"
+
+// Zero-initialised statics are valid atomics on every platform the layer supports
+static PlatformAtomicUInt32 g_queue_depth_high_water;
+static PlatformAtomicUInt64 g_entries_written;
+static PlatformAtomicUInt64 g_drain_batches;
+static PlatformAtomicUInt64 g_drain_busy_ns;
+static LoggerHistogram g_push_latency;
+static LoggerHistogram g_rotation_time;
+
+/**
+ * @brief Raises an atomic to a value if it is below it.
+ */
+static void atomic_max_uint64(PlatformAtomicUInt64* target, uint64_t value) {
+    uint64_t current = platform_atomic_load_uint64(target);
+    while (value > current &&
+           !platform_atomic_compare_exchange_uint64(target, &current, value)) {
+    }
+}
+
+void logger_histogram_record(LoggerHistogram* histogram, uint64_t value) {
+    uint32_t bucket = 0;
+    for (uint64_t v = value; v && bucket < LOGGER_HISTOGRAM_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    platform_atomic_fetch_add_uint64(&histogram->buckets[bucket], 1);
+    platform_atomic_fetch_add_uint64(&histogram->count, 1);
+    platform_atomic_fetch_add_uint64(&histogram->sum, value);
+    atomic_max_uint64(&histogram->max, value);
+}
+
+static void histogram_snapshot(LoggerHistogram* histogram, LoggerHistogramSnapshot* snapshot) {
+    for (int i = 0; i < LOGGER_HISTOGRAM_BUCKETS; i++) {
+        snapshot->buckets[i] = platform_atomic_load_uint64(&histogram->buckets[i]);
+    }
+    snapshot->count = platform_atomic_load_uint64(&histogram->count);
+    snapshot->sum = platform_atomic_load_uint64(&histogram->sum);
+    snapshot->max = platform_atomic_load_uint64(&histogram->max);
+}
+
+uint64_t logger_histogram_percentile(const LoggerHistogramSnapshot* snapshot, double percentile) {
+    uint64_t total = 0;
+    for (int i = 0; i < LOGGER_HISTOGRAM_BUCKETS; i++) {
+        total += snapshot->buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(total * percentile / 100.0);
+    uint64_t seen = 0;
+    for (int i = 0; i < LOGGER_HISTOGRAM_BUCKETS; i++) {
+        seen += snapshot->buckets[i];
+        if (seen > rank) {
+            uint64_t upper = (i == 0) ? 0 : (((uint64_t)1 << i) - 1);
+            return (upper < snapshot->max) ? upper : snapshot->max;
+        }
+    }
+    return snapshot->max;
+}
+
+void logger_metrics_record_push(uint64_t latency_ns) {
+    logger_histogram_record(&g_push_latency, latency_ns);
+}
+
+void logger_metrics_record_depth(uint32_t ring_depth_bytes) {
+    // A plain load on the common path; only a new high-water mark writes
+    uint32_t current = platform_atomic_load_uint32(&g_queue_depth_high_water);
+    while (ring_depth_bytes > current &&
+           !platform_atomic_compare_exchange_uint32(&g_queue_depth_high_water, &current, ring_depth_bytes)) {
+    }
+}
+
+void logger_metrics_record_drain(uint32_t entries, uint64_t elapsed_ns) {
+    platform_atomic_fetch_add_uint64(&g_entries_written, entries);
+    platform_atomic_fetch_add_uint64(&g_drain_batches, 1);
+    platform_atomic_fetch_add_uint64(&g_drain_busy_ns, elapsed_ns);
+}
+
+void logger_metrics_record_rotation(uint64_t elapsed_ns) {
+    logger_histogram_record(&g_rotation_time, elapsed_ns);
+}
+
+void logger_metrics_get(LoggerMetrics* metrics) {
+    if (!metrics) {
+        return;
+    }
+
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->entries_written = platform_atomic_load_uint64(&g_entries_written);
+    metrics->entries_dropped = log_queue_dropped_count(&global_log_queue);
+    metrics->drain_batches = platform_atomic_load_uint64(&g_drain_batches);
+    metrics->drain_busy_ns = platform_atomic_load_uint64(&g_drain_busy_ns);
+    metrics->queue_depth_bytes = log_queue_depth_bytes(&global_log_queue);
+    metrics->queue_depth_high_water = platform_atomic_load_uint32(&g_queue_depth_high_water);
+    metrics->ring_bytes = LOG_RING_BYTES;
+    histogram_snapshot(&g_push_latency, &metrics->push_latency_ns);
+    histogram_snapshot(&g_rotation_time, &metrics->rotation_ns);
+    metrics->file_count = logger_get_file_metrics(metrics->files, LOGGER_METRICS_MAX_FILES);
+}
+
+/**
+ * @brief Appends formatted text to a buffer, keeping track of the space left.
+ */
+static void append(char* buffer, size_t size, size_t* used, const char* format, ...) {
+    if (*used >= size) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + *used, size - *used, format, args);
+    va_end(args);
+    if (written > 0) {
+        *used += (size_t)written;
+    }
+}
+
+void logger_metrics_format_summary(const LoggerMetrics* now, const LoggerMetrics* previous,
+                                   uint32_t elapsed_ms, char* buffer, size_t size) {
+    if (!now || !buffer || size == 0) {
+        return;
+    }
+
+    static const LoggerMetrics zero = {0};
+    if (!previous) {
+        previous = &zero;
+    }
+
+    uint64_t written = now->entries_written - previous->entries_written;
+    uint64_t batches = now->drain_batches - previous->drain_batches;
+    uint64_t busy_ns = now->drain_busy_ns - previous->drain_busy_ns;
+    double seconds = elapsed_ms ? elapsed_ms / 1000.0 : 1.0;
+    size_t used = 0;
+
+    buffer[0] = '\0';
+    append(buffer, size, &used, "Logger metrics: %llu written (%.1f/s, %llu batches, %.1f%% busy), %llu dropped",
+           (unsigned long long)written, written / seconds, (unsigned long long)batches,
+           busy_ns / (seconds * 1e7), (unsigned long long)(now->entries_dropped - previous->entries_dropped));
+    append(buffer, size, &used, ", queue %u B, high-water %u B (%.0f%% of a ring)",
+           now->queue_depth_bytes, now->queue_depth_high_water,
+           100.0 * now->queue_depth_high_water / now->ring_bytes);
+    append(buffer, size, &used, ", push p50 %llu ns p99 %llu ns max %llu ns",
+           (unsigned long long)logger_histogram_percentile(&now->push_latency_ns, 50),
+           (unsigned long long)logger_histogram_percentile(&now->push_latency_ns, 99),
+           (unsigned long long)now->push_latency_ns.max);
+    if (now->rotation_ns.count) {
+        append(buffer, size, &used, ", %llu rotations (max %.1f ms)",
+               (unsigned long long)now->rotation_ns.count, now->rotation_ns.max / 1e6);
+    }
+
+    for (int i = 0; i < now->file_count; i++) {
+        uint64_t before = 0;
+        for (int j = 0; j < previous->file_count; j++) {
+            if (strcmp(previous->files[j].file_name, now->files[i].file_name) == 0) {
+                before = previous->files[j].bytes_written;
+                break;
+            }
+        }
+        append(buffer, size, &used, "%s %s +%llu B", i ? "," : ";", now->files[i].file_name,
+               (unsigned long long)(now->files[i].bytes_written - before));
+    }
+}
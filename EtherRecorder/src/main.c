@@ -15,6 +15,7 @@
 #include "app_thread.h"
 #include "thread_registry.h"
 #include "shutdown_handler.h"
+#include "message_pool.h"
 #include "message_types.h"
 #include "version_info.h"
 
@@ -86,6 +87,12 @@ static PlatformErrorCode init_app(void) {
         logger_log(LOG_INFO, "Configuration: %s", config_load_result);
     }
 
+    // Message buffers, before any thread that sends messages, the logger's included
+    if (!message_pool_init()) {
+        printf("Failed to initialise message pool\n");
+        return PLATFORM_ERROR_SYSTEM;
+    }
+
     // Initialize logger
     char logger_init_result[LOG_MSG_BUFFER_SIZE];
     if (!init_logger_from_config(logger_init_result)) {
@@ -132,6 +139,7 @@ static PlatformErrorCode cleanup_app(void) {
     platform_socket_cleanup();
     cleanup_shutdown_handler();
     logger_close();
+    message_pool_cleanup();
     free_config();
     
     // Ensure terminal is in a good state before exit
@@ -150,28 +158,30 @@ static PlatformErrorCode cleanup_app(void) {
 
 static bool send_demo_text_message(void) {
     const char* msg_text = "Message from main thread";
-    Message_T message = {0};  // Zero-initialize the entire structure
-    message.header.type = MSG_TYPE_TEST;
     size_t content_len = platform_strlen(msg_text) + 1;  // Include null terminator
     if (content_len > UINT32_MAX) {
         logger_log(LOG_ERROR, "Message length exceeds maximum allowed size");
         return false;
     }
-    message.header.content_size = (uint32_t)content_len;
     
-    if (message.header.content_size > sizeof(message.content)) {
-        logger_log(LOG_ERROR, "Message too long for content buffer");
+    MessageQueue_T* demo_queue = get_queue_by_label("DEMO_HEARTBEAT");
+    if (!demo_queue) {
         return false;
     }
     
-    memcpy(message.content, msg_text, message.header.content_size);
-    
-    MessageQueue_T* demo_queue = get_queue_by_label("DEMO_HEARTBEAT");
-    if (!demo_queue) {
+    Message_T* message = message_alloc(MSG_TYPE_TEST, content_len);
+    if (!message) {
+        logger_log(LOG_ERROR, "Message too long for content buffer");
         return false;
     }
+    message->header.content_size = (uint32_t)content_len;
+    memcpy(message->content, msg_text, message->header.content_size);
     
-    return message_queue_push(demo_queue, &message, 100);
+    if (!message_queue_push(demo_queue, message, 100)) {
+        message_release(message);
+        return false;
+    }
+    return true;
 }
 
 int main(int argc, char *argv[]) {
@@ -203,7 +213,7 @@ int main(int argc, char *argv[]) {
             // logger_log(LOG_ERROR, "Failed to send demo message");
         }
         
-        logger_log(LOG_DEBUG, "HEARTBEAT");
+        logger_log_limited(LOG_DEBUG, "HEARTBEAT");
         sleep_ms(762);
     }
     
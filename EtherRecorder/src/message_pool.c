@@ -0,0 +1,206 @@
+/**
+ * @file message_pool.c
+ * @brief Reference-counted message buffers, allocated from size-classed slabs.
+ *
+ * Each buffer is a MessageBuffer_T header followed by the Message_T handed
+ * out and its content. Free buffers of a size class form a stack linked by
+ * buffer number; the stack head packs the top buffer number with a counter
+ * bumped on every change, so a pop cannot be fooled by the same buffer
+ * having been popped and pushed back in between.
+ */
+
+#include "message_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger.h"
+#include "platform_atomic.h"
+#include "platform_mutex.h"
+
+#define MESSAGE_BUFFER_NONE 0  // Free list link meaning no buffer; buffer numbers start at 1
+#define MESSAGE_SIZE_CLASS_COUNT 4
+
+// Content capacity of each size class, smallest first; the last is MESSAGE_MAX_CONTENT_SIZE
+static const size_t g_size_classes[MESSAGE_SIZE_CLASS_COUNT] = {
+    256, 2048, 16384, MESSAGE_MAX_CONTENT_SIZE
+};
+
+typedef struct MessageBuffer_T {
+    PlatformAtomicUInt32 refcount;  // References held; 0 while on the free list
+    uint32_t number;                // 1-based position in its size class, slab by slab
+    PlatformAtomicUInt32 next_free; // Number of the buffer below this one on the free list
+    uint32_t size_class;            // Index into g_size_classes
+} MessageBuffer_T;
+
+typedef struct MessageSizeClass_T {
+    PlatformAtomicUInt64 free_top;  // Counter in the high half, buffer number in the low half
+    uint8_t free_top_pad[MESSAGE_QUEUE_CACHE_LINE_SIZE - sizeof(PlatformAtomicUInt64)];
+    uint8_t* slabs[MESSAGE_POOL_MAX_SLABS];
+    PlatformAtomicUInt32 slab_count;
+    uint32_t buffers_per_slab;
+    size_t stride;                  // Bytes from one buffer to the next
+} MessageSizeClass_T;
+
+typedef struct MessagePool_T {
+    MessageSizeClass_T classes[MESSAGE_SIZE_CLASS_COUNT];
+    PlatformMutex_T grow_mutex;     // Serialises adding slabs
+    bool initialised;
+} MessagePool_T;
+
+static MessagePool_T g_message_pool;
+
+static MessageBuffer_T* buffer_from_number(const MessageSizeClass_T* size_class, uint32_t number) {
+    uint32_t index = number - 1;
+    return (MessageBuffer_T*)(size_class->slabs[index / size_class->buffers_per_slab] +
+                              (size_t)(index % size_class->buffers_per_slab) * size_class->stride);
+}
+
+static MessageBuffer_T* buffer_from_message(Message_T* message) {
+    return (MessageBuffer_T*)message - 1;
+}
+
+static void push_free(MessageSizeClass_T* size_class, MessageBuffer_T* buffer) {
+    uint64_t top = platform_atomic_load_uint64(&size_class->free_top);
+    do {
+        platform_atomic_store_explicit_uint32(&buffer->next_free, (uint32_t)top, PLATFORM_MEMORY_ORDER_RELAXED);
+    } while (!platform_atomic_compare_exchange_uint64(&size_class->free_top, &top,
+                 ((top >> 32) + 1) << 32 | buffer->number));
+}
+
+static MessageBuffer_T* pop_free(MessageSizeClass_T* size_class) {
+    uint64_t top = platform_atomic_load_uint64(&size_class->free_top);
+    for (;;) {
+        uint32_t number = (uint32_t)top;
+        if (number == MESSAGE_BUFFER_NONE) {
+            return NULL;
+        }
+        // Buffers are never freed while the pool is up, so reading a stale link is harmless
+        MessageBuffer_T* buffer = buffer_from_number(size_class, number);
+        uint64_t next = ((top >> 32) + 1) << 32 |
+                        platform_atomic_load_explicit_uint32(&buffer->next_free, PLATFORM_MEMORY_ORDER_RELAXED);
+        if (platform_atomic_compare_exchange_uint64(&size_class->free_top, &top, next)) {
+            return buffer;
+        }
+    }
+}
+
+/**
+ * @brief Adds a slab to a size class unless another thread just did.
+ * @return false if the class is at MESSAGE_POOL_MAX_SLABS or out of memory.
+ */
+static bool grow_size_class(uint32_t class_index) {
+    MessageSizeClass_T* size_class = &g_message_pool.classes[class_index];
+    platform_mutex_lock(&g_message_pool.grow_mutex);
+
+    // Someone else may have refilled the free list while this thread waited
+    if ((uint32_t)platform_atomic_load_uint64(&size_class->free_top) != MESSAGE_BUFFER_NONE) {
+        platform_mutex_unlock(&g_message_pool.grow_mutex);
+        return true;
+    }
+
+    uint32_t slab = platform_atomic_load_uint32(&size_class->slab_count);
+    uint8_t* buffers = NULL;
+    if (slab < MESSAGE_POOL_MAX_SLABS) {
+        buffers = (uint8_t*)calloc(size_class->buffers_per_slab, size_class->stride);
+    }
+    if (!buffers) {
+        platform_mutex_unlock(&g_message_pool.grow_mutex);
+        return false;
+    }
+
+    size_class->slabs[slab] = buffers;
+    platform_atomic_store_uint32(&size_class->slab_count, slab + 1);
+    for (uint32_t i = 0; i < size_class->buffers_per_slab; i++) {
+        MessageBuffer_T* buffer = (MessageBuffer_T*)(buffers + (size_t)i * size_class->stride);
+        buffer->number = slab * size_class->buffers_per_slab + i + 1;
+        buffer->size_class = class_index;
+        push_free(size_class, buffer);
+    }
+
+    platform_mutex_unlock(&g_message_pool.grow_mutex);
+    return true;
+}
+
+bool message_pool_init(void) {
+    if (g_message_pool.initialised) {
+        return true;
+    }
+    memset(&g_message_pool, 0, sizeof(g_message_pool));
+    for (uint32_t i = 0; i < MESSAGE_SIZE_CLASS_COUNT; i++) {
+        MessageSizeClass_T* size_class = &g_message_pool.classes[i];
+        size_t bytes = sizeof(MessageBuffer_T) + sizeof(Message_T) + g_size_classes[i];
+        size_class->stride = (bytes + MESSAGE_QUEUE_CACHE_LINE_SIZE - 1) & ~(size_t)(MESSAGE_QUEUE_CACHE_LINE_SIZE - 1);
+        size_class->buffers_per_slab = (uint32_t)(MESSAGE_POOL_SLAB_BYTES / size_class->stride);
+        if (size_class->buffers_per_slab == 0) {
+            size_class->buffers_per_slab = 1;
+        }
+        platform_atomic_init_uint64(&size_class->free_top, MESSAGE_BUFFER_NONE);
+        platform_atomic_init_uint32(&size_class->slab_count, 0);
+    }
+    if (platform_mutex_init(&g_message_pool.grow_mutex) != PLATFORM_ERROR_SUCCESS) {
+        return false;
+    }
+    g_message_pool.initialised = true;
+    return true;
+}
+
+void message_pool_cleanup(void) {
+    if (!g_message_pool.initialised) {
+        return;
+    }
+    for (uint32_t i = 0; i < MESSAGE_SIZE_CLASS_COUNT; i++) {
+        MessageSizeClass_T* size_class = &g_message_pool.classes[i];
+        uint32_t slab_count = platform_atomic_load_uint32(&size_class->slab_count);
+        for (uint32_t slab = 0; slab < slab_count; slab++) {
+            free(size_class->slabs[slab]);
+            size_class->slabs[slab] = NULL;
+        }
+    }
+    platform_mutex_destroy(&g_message_pool.grow_mutex);
+    g_message_pool.initialised = false;
+}
+
+Message_T* message_alloc(MessageType type, size_t capacity) {
+    if (!g_message_pool.initialised || capacity > MESSAGE_MAX_CONTENT_SIZE) {
+        return NULL;
+    }
+
+    uint32_t class_index = 0;
+    while (g_size_classes[class_index] < capacity) {
+        class_index++;
+    }
+    MessageSizeClass_T* size_class = &g_message_pool.classes[class_index];
+
+    MessageBuffer_T* buffer = pop_free(size_class);
+    while (!buffer) {
+        if (!grow_size_class(class_index)) {
+            logger_log(LOG_ERROR, "Message pool exhausted for %zu byte messages", g_size_classes[class_index]);
+            return NULL;
+        }
+        buffer = pop_free(size_class);
+    }
+
+    platform_atomic_store_uint32(&buffer->refcount, 1);
+    Message_T* message = (Message_T*)(buffer + 1);
+    message->header.type = type;
+    message->header.content_size = 0;
+    message->header.capacity = g_size_classes[class_index];
+    return message;
+}
+
+void message_retain(Message_T* message) {
+    if (message) {
+        platform_atomic_fetch_add_uint32(&buffer_from_message(message)->refcount, 1);
+    }
+}
+
+void message_release(Message_T* message) {
+    if (!message) {
+        return;
+    }
+    MessageBuffer_T* buffer = buffer_from_message(message);
+    if (platform_atomic_fetch_add_uint32(&buffer->refcount, (uint32_t)-1) == 1) {
+        push_free(&g_message_pool.classes[buffer->size_class], buffer);
+    }
+}
@@ -1,61 +1,276 @@
 #include "message_types.h"
 
 #include "logger.h"
+#include "message_pool.h"
 #include <string.h>
 #include <stdlib.h>
 
 #include "platform_threads.h"
+#include "platform_time.h"
 
-bool message_queue_push(MessageQueue_T* queue, const Message_T* message, uint32_t timeout_ms) {
-    if (!queue || !message) {
-        logger_log(LOG_ERROR, "Invalid parameters for message queue push");
+#define ACQUIRE PLATFORM_MEMORY_ORDER_ACQUIRE
+#define RELEASE PLATFORM_MEMORY_ORDER_RELEASE
+#define RELAXED PLATFORM_MEMORY_ORDER_RELAXED
+
+bool message_queue_init(MessageQueue_T* queue, uint32_t max_size, MessageQueueMode mode, const char* owner_label) {
+    if (!queue || max_size == 0 || (max_size & (max_size - 1)) != 0) {
         return false;
     }
 
-    // First check if queue is full before waiting
-    int32_t next_tail = (queue->tail + 1) % queue->max_size;
-    if (next_tail == queue->head) {
-        if (!platform_event_wait(queue->not_full_event, timeout_ms)) {
-            logger_log(LOG_ERROR, "Queue full timeout (owner: %s)", queue->owner_label);
+    memset(queue, 0, sizeof(*queue));
+    queue->entries = (Message_T**)calloc(max_size, sizeof(Message_T*));
+    if (!queue->entries) {
+        return false;
+    }
+    if (mode == MESSAGE_QUEUE_MPMC) {
+        queue->sequences = (PlatformAtomicUInt32*)calloc(max_size, sizeof(PlatformAtomicUInt32));
+        if (!queue->sequences) {
+            free(queue->entries);
             return false;
         }
-        // Recheck after wait
-        next_tail = (queue->tail + 1) % queue->max_size;
-        if (next_tail == queue->head) {
-            logger_log(LOG_ERROR, "Queue still full after wait (owner: %s)", queue->owner_label);
-            return false;
+        for (uint32_t i = 0; i < max_size; i++) {
+            platform_atomic_init_uint32(&queue->sequences[i], i);
         }
     }
 
-    memcpy(&queue->entries[queue->tail], message, sizeof(Message_T));
-    queue->tail = next_tail;
+    queue->max_size = max_size;
+    queue->mask = max_size - 1;
+    queue->mode = mode;
+    queue->owner_label = owner_label;
+    platform_atomic_init_uint32(&queue->head, 0);
+    platform_atomic_init_uint32(&queue->tail, 0);
+    platform_atomic_init_uint32(&queue->wakeups, 0);
 
-    platform_event_set(queue->not_empty_event);
+    if (platform_event_create(&queue->not_empty_event, false, false) != PLATFORM_ERROR_SUCCESS) {
+        free(queue->sequences);
+        free(queue->entries);
+        return false;
+    }
+    if (platform_event_create(&queue->not_full_event, false, true) != PLATFORM_ERROR_SUCCESS) {
+        platform_event_destroy(queue->not_empty_event);
+        free(queue->sequences);
+        free(queue->entries);
+        return false;
+    }
     return true;
 }
 
-bool message_queue_pop(MessageQueue_T* queue, Message_T* message, uint32_t timeout_ms) {
-    if (!queue || !message) {
-        logger_log(LOG_ERROR, "Invalid parameters for message queue pop");
-        return false;
+/**
+ * @brief Puts as many of count message handles on the queue as fit, without waiting.
+ * @return The number queued, from the start of messages.
+ */
+static uint32_t try_push(MessageQueue_T* queue, Message_T* const* messages, uint32_t count) {
+    if (queue->mode == MESSAGE_QUEUE_SPSC) {
+        // Only this thread moves tail; head is read with acquire so the slots are really free
+        uint32_t tail = platform_atomic_load_explicit_uint32(&queue->tail, RELAXED);
+        uint32_t head = platform_atomic_load_explicit_uint32(&queue->head, ACQUIRE);
+        uint32_t room = queue->max_size - (tail - head);
+        uint32_t n = count < room ? count : room;
+        for (uint32_t i = 0; i < n; i++) {
+            queue->entries[(tail + i) & queue->mask] = messages[i];
+        }
+        if (n > 0) {
+            platform_atomic_store_explicit_uint32(&queue->tail, tail + n, RELEASE);
+        }
+        return n;
     }
 
-    // First check if queue is empty before waiting
-    if (queue->head == queue->tail) {
-        if (!platform_event_wait(queue->not_empty_event, timeout_ms)) {
-            // logger_log(LOG_DEBUG, "Queue empty timeout");
-            return false;
+    uint32_t position = platform_atomic_load_explicit_uint32(&queue->tail, RELAXED);
+    for (;;) {
+        PlatformAtomicUInt32* sequence = &queue->sequences[position & queue->mask];
+        int32_t turn = (int32_t)(platform_atomic_load_explicit_uint32(sequence, ACQUIRE) - position);
+        if (turn < 0) {
+            // The slot still holds the message from a lap ago
+            return 0;
+        }
+        if (turn > 0) {
+            position = platform_atomic_load_explicit_uint32(&queue->tail, RELAXED);
+            continue;
         }
-        // Recheck after wait
-        if (queue->head == queue->tail) {
-            // logger_log(LOG_DEBUG, "Queue still empty after wait");
+
+        // The run of slots free for this lap from position on, claimed together or not at all
+        uint32_t n = 1;
+        while (n < count &&
+               platform_atomic_load_explicit_uint32(&queue->sequences[(position + n) & queue->mask], ACQUIRE) ==
+               position + n) {
+            n++;
+        }
+        if (platform_atomic_compare_exchange_uint32(&queue->tail, &position, position + n)) {
+            for (uint32_t i = 0; i < n; i++) {
+                queue->entries[(position + i) & queue->mask] = messages[i];
+                platform_atomic_store_explicit_uint32(&queue->sequences[(position + i) & queue->mask],
+                                                      position + i + 1, RELEASE);
+            }
+            return n;
+        }
+        // Another producer claimed position first; position now holds the current tail
+    }
+}
+
+/**
+ * @brief Takes up to max_count of the oldest message handles off the queue, without waiting.
+ * @return The number taken.
+ */
+static uint32_t try_pop(MessageQueue_T* queue, Message_T** messages, uint32_t max_count) {
+    if (queue->mode == MESSAGE_QUEUE_SPSC) {
+        uint32_t head = platform_atomic_load_explicit_uint32(&queue->head, RELAXED);
+        uint32_t tail = platform_atomic_load_explicit_uint32(&queue->tail, ACQUIRE);
+        uint32_t queued = tail - head;
+        uint32_t n = max_count < queued ? max_count : queued;
+        for (uint32_t i = 0; i < n; i++) {
+            messages[i] = queue->entries[(head + i) & queue->mask];
+        }
+        if (n > 0) {
+            platform_atomic_store_explicit_uint32(&queue->head, head + n, RELEASE);
+        }
+        return n;
+    }
+
+    uint32_t position = platform_atomic_load_explicit_uint32(&queue->head, RELAXED);
+    for (;;) {
+        PlatformAtomicUInt32* sequence = &queue->sequences[position & queue->mask];
+        int32_t turn = (int32_t)(platform_atomic_load_explicit_uint32(sequence, ACQUIRE) - (position + 1));
+        if (turn < 0) {
+            // Nothing published at this position yet
+            return 0;
+        }
+        if (turn > 0) {
+            position = platform_atomic_load_explicit_uint32(&queue->head, RELAXED);
+            continue;
+        }
+
+        // The run of published slots from position on
+        uint32_t n = 1;
+        while (n < max_count &&
+               platform_atomic_load_explicit_uint32(&queue->sequences[(position + n) & queue->mask], ACQUIRE) ==
+               position + n + 1) {
+            n++;
+        }
+        if (platform_atomic_compare_exchange_uint32(&queue->head, &position, position + n)) {
+            for (uint32_t i = 0; i < n; i++) {
+                messages[i] = queue->entries[(position + i) & queue->mask];
+                // Hand the slot to the producer one lap on
+                platform_atomic_store_explicit_uint32(&queue->sequences[(position + i) & queue->mask],
+                                                      position + i + queue->max_size, RELEASE);
+            }
+            return n;
+        }
+    }
+}
+
+/**
+ * @brief Waits on one of the queue's events for what is left of a timeout.
+ * @return false once the timeout has run out.
+ */
+static bool wait_for_event(PlatformEvent_T event, uint32_t timeout_ms, uint32_t start) {
+    uint32_t wait_ms = timeout_ms;
+    if (timeout_ms != PLATFORM_WAIT_INFINITE) {
+        uint32_t now = 0;
+        platform_get_tick_count(&now);
+        if (now - start >= timeout_ms) {
             return false;
         }
+        wait_ms = timeout_ms - (now - start);
+    }
+    PlatformErrorCode result = platform_event_wait(event, wait_ms);
+    return result == PLATFORM_ERROR_SUCCESS || result == PLATFORM_ERROR_TIMEOUT;
+}
+
+uint32_t message_queue_push_batch(MessageQueue_T* queue, Message_T* const* messages, uint32_t count,
+                                  uint32_t timeout_ms) {
+    if (!queue || !messages) {
+        logger_log(LOG_ERROR, "Invalid parameters for message queue push");
+        return 0;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // The consumer is woken once for everything queued, and before this thread waits for room
+    uint32_t start = 0;
+    uint32_t pushed = 0;
+    uint32_t signalled = 0;
+    platform_get_tick_count(&start);
+    for (;;) {
+        pushed += try_push(queue, messages + pushed, count - pushed);
+        if (pushed == count) {
+            break;
+        }
+        if (pushed > signalled) {
+            platform_event_set(queue->not_empty_event);
+            signalled = pushed;
+        }
+        // The event can be left set by an earlier pop, so every wake up is rechecked
+        if (timeout_ms == 0 || !wait_for_event(queue->not_full_event, timeout_ms, start)) {
+            logger_log(LOG_ERROR, "Queue full timeout (owner: %s)", queue->owner_label);
+            break;
+        }
     }
 
-    memcpy(message, &queue->entries[queue->head], sizeof(Message_T));
-    queue->head = (queue->head + 1) % queue->max_size;
+    if (pushed > signalled) {
+        platform_event_set(queue->not_empty_event);
+    }
+    return pushed;
+}
+
+uint32_t message_queue_pop_batch(MessageQueue_T* queue, Message_T** messages, uint32_t max_count,
+                                 uint32_t timeout_ms) {
+    if (!queue || !messages || max_count == 0) {
+        logger_log(LOG_ERROR, "Invalid parameters for message queue pop");
+        return 0;
+    }
+
+    uint32_t start = 0;
+    uint32_t popped = 0;
+    uint32_t wakeups = platform_atomic_load_uint32(&queue->wakeups);
+    platform_get_tick_count(&start);
+    while ((popped = try_pop(queue, messages, max_count)) == 0) {
+        if (timeout_ms == 0 || !wait_for_event(queue->not_empty_event, timeout_ms, start)) {
+            // logger_log(LOG_DEBUG, "Queue empty timeout");
+            return 0;
+        }
+        if (platform_atomic_load_uint32(&queue->wakeups) != wakeups) {
+            popped = try_pop(queue, messages, max_count);
+            break;
+        }
+    }
+    if (popped == 0) {
+        return 0;
+    }
 
     platform_event_set(queue->not_full_event);
-    return true;
+    return popped;
+}
+
+bool message_queue_push(MessageQueue_T* queue, Message_T* message, uint32_t timeout_ms) {
+    return message_queue_push_batch(queue, &message, 1, timeout_ms) == 1;
+}
+
+bool message_queue_pop(MessageQueue_T* queue, Message_T** message, uint32_t timeout_ms) {
+    return message_queue_pop_batch(queue, message, 1, timeout_ms) == 1;
+}
+
+void message_queue_wake(MessageQueue_T* queue) {
+    if (!queue) {
+        return;
+    }
+    platform_atomic_fetch_add_uint32(&queue->wakeups, 1);
+    platform_event_set(queue->not_empty_event);
+}
+
+void message_queue_destroy(MessageQueue_T* queue) {
+    if (!queue) {
+        return;
+    }
+    // Whatever is still queued goes back to the pool
+    Message_T* message = NULL;
+    while (queue->entries && try_pop(queue, &message, 1)) {
+        message_release(message);
+    }
+    platform_event_destroy(queue->not_empty_event);
+    platform_event_destroy(queue->not_full_event);
+    free(queue->sequences);
+    free(queue->entries);
+    queue->sequences = NULL;
+    queue->entries = NULL;
 }
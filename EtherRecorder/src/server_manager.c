@@ -93,7 +93,7 @@ static PlatformErrorCode handle_connection(CommContext* base_context) {
     ThreadConfig receive_thread_config = create_thread_config(
         "SERVER.RECEIVE", 
         (ThreadFunc_T)comm_receive_thread, 
-        &receive_thread_config
+        &recv_context
     );
 
     // Check if file sending is enabled for server
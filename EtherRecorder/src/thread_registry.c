@@ -215,9 +215,7 @@ void thread_registry_cleanup(void) {
 
         // Clean up message queue if it exists
         if (current->queue) {
-            platform_event_destroy(current->queue->not_empty_event);
-            platform_event_destroy(current->queue->not_full_event);
-            free(current->queue->entries);
+            message_queue_destroy(current->queue);
             free(current->queue);
         }
 
@@ -267,7 +265,7 @@ ThreadRegistryError init_queue(
         return THREAD_REG_NOT_INITIALIZED;
     }
 
-    uint32_t max_size = 1024;  // Default size
+    uint32_t max_size = 1024;  // Default size, a power of two
     if (!validate_thread_label(thread_label) || max_size == 0) {
         return THREAD_REG_INVALID_ARGS;
     }
@@ -295,35 +293,8 @@ ThreadRegistryError init_queue(
         return THREAD_REG_CREATION_FAILED;
     }
 
-    // Allocate message entries
-    entry->queue->entries = (Message_T*)calloc(max_size, sizeof(Message_T));
-    if (!entry->queue->entries) {
-        free(entry->queue);
-        entry->queue = NULL;
-        platform_mutex_unlock(&g_registry.mutex);
-        return THREAD_REG_CREATION_FAILED;
-    }
-
-    // Initialize queue fields
-    entry->queue->max_size = max_size;
-    entry->queue->head = 0;
-    entry->queue->tail = 0;
-    entry->queue->owner_label = thread_label;  // Set the owner label
-
-    // Create synchronization events
-    PlatformErrorCode err = platform_event_create(&entry->queue->not_empty_event, false, false);
-    if (err != PLATFORM_ERROR_SUCCESS) {
-        free(entry->queue->entries);
-        free(entry->queue);
-        entry->queue = NULL;
-        platform_mutex_unlock(&g_registry.mutex);
-        return THREAD_REG_CREATION_FAILED;
-    }
-
-    err = platform_event_create(&entry->queue->not_full_event, false, true);
-    if (err != PLATFORM_ERROR_SUCCESS) {
-        platform_event_destroy(entry->queue->not_empty_event);
-        free(entry->queue->entries);
+    // Ring, indices and events, as the thread configured it
+    if (!message_queue_init(entry->queue, max_size, entry->thread->queue_mode, thread_label)) {
         free(entry->queue);
         entry->queue = NULL;
         platform_mutex_unlock(&g_registry.mutex);
@@ -334,16 +305,22 @@ ThreadRegistryError init_queue(
     return THREAD_REG_SUCCESS;
 }
 
-ThreadRegistryError push_message(
+ThreadRegistryError push_messages(
     const char* thread_label,
-    const Message_T* message,
-    uint32_t timeout_ms
+    Message_T* const* messages,
+    uint32_t count,
+    uint32_t timeout_ms,
+    uint32_t* pushed
 ) {
+    if (pushed) {
+        *pushed = 0;
+    }
+
     if (!g_registry_initialized) {
         return THREAD_REG_NOT_INITIALIZED;
     }
 
-    if (!validate_thread_label(thread_label) || !message) {
+    if (!validate_thread_label(thread_label) || !messages || count == 0) {
         return THREAD_REG_INVALID_ARGS;
     }
 
@@ -360,23 +337,33 @@ ThreadRegistryError push_message(
     MessageQueue_T* queue = entry->queue;
     platform_mutex_unlock(&g_registry.mutex);
 
-    if (!message_queue_push(queue, message, timeout_ms)) {
+    uint32_t queued = message_queue_push_batch(queue, messages, count, timeout_ms);
+    if (pushed) {
+        *pushed = queued;
+    }
+    if (queued < count) {
         return THREAD_REG_QUEUE_FULL;
     }
 
     return THREAD_REG_SUCCESS;
 }
 
-ThreadRegistryError pop_message(
+ThreadRegistryError pop_messages(
     const char* thread_label,
-    Message_T* message,
-    uint32_t timeout_ms
+    Message_T** messages,
+    uint32_t max_count,
+    uint32_t timeout_ms,
+    uint32_t* popped
 ) {
+    if (popped) {
+        *popped = 0;
+    }
+
     if (!g_registry_initialized) {
         return THREAD_REG_NOT_INITIALIZED;
     }
 
-    if (!validate_thread_label(thread_label) || !message) {
+    if (!validate_thread_label(thread_label) || !messages || max_count == 0 || !popped) {
         return THREAD_REG_INVALID_ARGS;
     }
 
@@ -400,13 +387,58 @@ ThreadRegistryError pop_message(
     MessageQueue_T* queue = entry->queue;
     platform_mutex_unlock(&g_registry.mutex);
 
-    if (!message_queue_pop(queue, message, timeout_ms)) {
+    *popped = message_queue_pop_batch(queue, messages, max_count, timeout_ms);
+    if (*popped == 0) {
         return THREAD_REG_QUEUE_EMPTY;
     }
 
     return THREAD_REG_SUCCESS;
 }
 
+ThreadRegistryError push_message(
+    const char* thread_label,
+    Message_T* message,
+    uint32_t timeout_ms
+) {
+    if (!message) {
+        return THREAD_REG_INVALID_ARGS;
+    }
+    return push_messages(thread_label, &message, 1, timeout_ms, NULL);
+}
+
+ThreadRegistryError pop_message(
+    const char* thread_label,
+    Message_T** message,
+    uint32_t timeout_ms
+) {
+    uint32_t popped = 0;
+    return pop_messages(thread_label, message, 1, timeout_ms, &popped);
+}
+
+ThreadRegistryError wake_queue(const char* thread_label) {
+    if (!g_registry_initialized) {
+        return THREAD_REG_NOT_INITIALIZED;
+    }
+
+    if (!validate_thread_label(thread_label)) {
+        return THREAD_REG_INVALID_ARGS;
+    }
+
+    if (platform_mutex_lock(&g_registry.mutex) != PLATFORM_ERROR_SUCCESS) {
+        return THREAD_REG_LOCK_ERROR;
+    }
+
+    ThreadRegistryEntry* entry = thread_registry_find_thread(thread_label);
+    if (!entry || !entry->queue) {
+        platform_mutex_unlock(&g_registry.mutex);
+        return THREAD_REG_NOT_FOUND;
+    }
+
+    message_queue_wake(entry->queue);
+    platform_mutex_unlock(&g_registry.mutex);
+    return THREAD_REG_SUCCESS;
+}
+
 MessageQueue_T* get_queue_by_label(const char* thread_label) {
     if (!validate_thread_label(thread_label)) {
         return NULL;
@@ -622,9 +654,7 @@ ThreadRegistryError thread_registry_deregister(const char* thread_label) {
             platform_event_destroy(entry->completion_event);
             
             if (entry->queue) {
-                platform_event_destroy(entry->queue->not_empty_event);
-                platform_event_destroy(entry->queue->not_full_event);
-                free(entry->queue->entries);
+                message_queue_destroy(entry->queue);
                 free(entry->queue);
             }
 
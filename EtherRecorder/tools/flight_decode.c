@@ -0,0 +1,176 @@
+/**
+ * @file flight_decode.c
+ * @brief Turns a flight recorder file back into log lines.
+ *
+ * Usage: flight_decode <flight recorder file> [output file]
+ *
+ * Reads the file left by log_flight_recorder.c, for instance
+ * /dev/shm/ether_recorder.flight, or its .prev copy after a restart, and
+ * writes the recorded entries oldest first in the log file line format.
+ * Slots that were being written when the process died are skipped. Must be
+ * built for the same platform as the EtherRecorder that wrote the file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "log_deferred.h"
+#include "log_flight_recorder.h"
+
+#define DECODE_MESSAGE_SIZE 1024  // As LOG_MSG_BUFFER_SIZE
+
+static const char* level_names[] = {
+    "TRACE", "DEBUG", "INFO", "NOTICE", "WARN", "ERROR", "CRITICAL", "FATAL"
+};
+
+static int compare_records(const void* a, const void* b) {
+    uint64_t left = (*(const FlightRecorderRecord* const*)a)->sequence.value;
+    uint64_t right = (*(const FlightRecorderRecord* const*)b)->sequence.value;
+    return (left > right) - (left < right);
+}
+
+static uint8_t* read_file(const char* file_name, size_t* size) {
+    FILE* file = fopen(file_name, "rb");
+    if (!file) {
+        return NULL;
+    }
+    uint8_t* data = NULL;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length > 0 && fseek(file, 0, SEEK_SET) == 0) {
+            data = malloc((size_t)length);
+            if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+                free(data);
+                data = NULL;
+            }
+            *size = (size_t)length;
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+/**
+ * @brief Writes one record as a log line: index, date and time, level, label, message.
+ */
+static void decode_record(FILE* out, const uint8_t* base, const FlightRecorderHeader* header,
+                          const FlightRecorderRecord* record) {
+    const char (*labels)[FLIGHT_RECORDER_LABEL_SIZE] =
+        (const char (*)[FLIGHT_RECORDER_LABEL_SIZE])(base + header->labels_offset);
+    const FlightRecorderFormat* formats = (const FlightRecorderFormat*)(base + header->formats_offset);
+
+    char message[DECODE_MESSAGE_SIZE];
+    if (record->format_id == FLIGHT_RECORDER_TEXT) {
+        size_t length = record->payload_size < sizeof(record->payload) ? record->payload_size : sizeof(record->payload);
+        memcpy(message, record->payload, length);
+        message[length] = '\0';
+    } else if (record->format_id >= header->format_count || !formats[record->format_id].ready.value) {
+        snprintf(message, sizeof(message), "<format %u not recorded>", record->format_id);
+    } else if (log_deferred_render(message, sizeof(message), formats[record->format_id].text,
+                                   record->payload, record->payload_size) < 0) {
+        snprintf(message, sizeof(message), "<malformed arguments for \"%s\">", formats[record->format_id].text);
+    }
+
+    // Calendar time from the recorder's reference point, as the logger does it;
+    // counters tick at the platform's rate, nanoseconds on POSIX but QPC ticks on Windows
+    int64_t elapsed = (int64_t)(record->timestamp - header->reference_counter);
+    int64_t frequency = (int64_t)header->counter_frequency;
+    int64_t elapsed_ns = elapsed / frequency * 1000000000 + elapsed % frequency * 1000000000 / frequency;
+    int64_t nanoseconds = header->reference_nanoseconds + elapsed_ns % 1000000000;
+    time_t seconds = (time_t)(header->reference_seconds + elapsed_ns / 1000000000);
+    if (nanoseconds < 0) {
+        nanoseconds += 1000000000;
+        seconds--;
+    } else if (nanoseconds >= 1000000000) {
+        nanoseconds -= 1000000000;
+        seconds++;
+    }
+    char date[32] = "";
+    struct tm* timeinfo = localtime(&seconds);
+    if (timeinfo) {
+        strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", timeinfo);
+    }
+
+    const char* label = record->label_id < FLIGHT_RECORDER_LABEL_COUNT && labels[record->label_id][0]
+        ? labels[record->label_id] : "UNKNOWN";
+    const char* level = record->level < sizeof(level_names) / sizeof(level_names[0])
+        ? level_names[record->level] : "UNKNOWN";
+    fprintf(out, "%07llu %s.%09lld %s: [%.*s] %s\n", (unsigned long long)record->index, date,
+            (long long)nanoseconds, level, FLIGHT_RECORDER_LABEL_SIZE, label, message);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <flight recorder file> [output file]\n", argv[0]);
+        return 2;
+    }
+
+    size_t size = 0;
+    uint8_t* base = read_file(argv[1], &size);
+    if (!base) {
+        fprintf(stderr, "Could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    const FlightRecorderHeader* header = (const FlightRecorderHeader*)base;
+    if (size < sizeof(*header) || memcmp(header->magic, FLIGHT_RECORDER_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != FLIGHT_RECORDER_VERSION || header->slot_size != FLIGHT_RECORDER_SLOT_SIZE ||
+        header->counter_frequency == 0 || header->counter_frequency > INT64_MAX / 1000000000 ||
+        header->slots_offset + (uint64_t)header->slot_count * header->slot_size > size ||
+        header->formats_offset + (uint64_t)header->format_count * sizeof(FlightRecorderFormat) > size ||
+        header->labels_offset + (uint64_t)FLIGHT_RECORDER_LABEL_COUNT * FLIGHT_RECORDER_LABEL_SIZE > size) {
+        fprintf(stderr, "%s is not a flight recorder file of this version\n", argv[1]);
+        free(base);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (argc == 3) {
+        out = fopen(argv[2], "w");
+        if (!out) {
+            fprintf(stderr, "Could not create %s\n", argv[2]);
+            free(base);
+            return 1;
+        }
+    }
+
+    // Slots are picked by entry index, so only the lap up to the newest index is current
+    const FlightRecorderRecord* slots = (const FlightRecorderRecord*)(base + header->slots_offset);
+    uint64_t newest = 0;
+    for (uint32_t i = 0; i < header->slot_count; i++) {
+        if (slots[i].sequence.value > newest) {
+            newest = slots[i].sequence.value;
+        }
+    }
+    uint64_t oldest = newest > header->slot_count ? newest - header->slot_count : 0;
+    const FlightRecorderRecord** records = malloc(sizeof(*records) * (header->slot_count ? header->slot_count : 1));
+    uint32_t count = 0;
+    uint32_t incomplete = 0;
+    for (uint32_t i = 0; records && i < header->slot_count; i++) {
+        uint64_t sequence = slots[i].sequence.value;
+        if (sequence > oldest) {
+            records[count++] = &slots[i];
+        } else if (sequence == 0 && slots[i].index != 0) {
+            incomplete++;
+        }
+    }
+    if (records) {
+        qsort(records, count, sizeof(*records), compare_records);
+        for (uint32_t i = 0; i < count; i++) {
+            decode_record(out, base, header, records[i]);
+        }
+    }
+
+    fprintf(stderr, "%u entries decoded up to index %llu, %u incomplete; %s\n", count,
+            (unsigned long long)newest, incomplete,
+            header->closed.value ? "the logger shut down cleanly" : "the logger did not shut down");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    free(records);
+    free(base);
+    return 0;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file log_search.c
+ * @brief Finds log lines by time, entry index, level and thread label across log files.
+ *
+ * Usage: log_search [options] <log file or .erlz archive>...
+ *   --from "YYYY-MM-DD HH:MM:SS"  Earliest log time shown (a T may stand for the space)
+ *   --to "YYYY-MM-DD HH:MM:SS"    Latest log time shown
+ *   --first N                     Lowest entry index shown
+ *   --last N                      Highest entry index shown
+ *   --level LEVEL                 Lowest level shown, e.g. WARN
+ *   --label LABEL                 Thread label shown, with its dotted children
+ *   --threads N                   Files scanned in parallel (default 4)
+ *
+ * A log file with an index beside it (see log_index.h) is read from the
+ * last index point before what is wanted, and only until its lines have
+ * gone past the range; an archive (see log_archive.h) only has the blocks
+ * overlapping the time range decompressed. Files are scanned in parallel
+ * and their matches printed in the order the files were given, so give
+ * rotations oldest first, e.g. by shell glob order.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "log_archive.h"
+#include "log_index.h"
+#include "platform_atomic.h"
+#include "platform_path.h"
+#include "platform_string.h"
+#include "platform_threads.h"
+
+#define SEARCH_LINE_SIZE 4096      // Longer lines are read in pieces, each treated as a continuation
+#define SEARCH_MAX_THREADS 32
+#define SEARCH_TIME_SLACK_S 2      // Lines are stamped before they are queued, so times are only nearly ordered
+
+typedef struct SearchFilter {
+    int64_t from;
+    int64_t to;
+    uint64_t first_index;
+    uint64_t last_index;
+    int min_level;            // Position in level_names, 0 for all
+    const char* label;        // NULL for all
+} SearchFilter;
+
+typedef struct SearchJob {
+    const char* path;
+    FILE* matches;            // Temporary file of the matching lines
+    uint64_t match_count;
+    bool failed;
+} SearchJob;
+
+typedef struct SearchContext {
+    const SearchFilter* filter;
+    SearchJob* jobs;
+    uint32_t job_count;
+    PlatformAtomicUInt32 next_job;
+} SearchContext;
+
+// Levels in order, as the logger writes them without their padding
+static const char* level_names[] = {
+    "TRACE", "DEBUG", "INFO", "NOTICE", "WARN", "ERROR", "CRITICAL", "FATAL"
+};
+#define LEVEL_COUNT ((int)(sizeof(level_names) / sizeof(level_names[0])))
+
+static int level_from_name(const char* name, size_t length) {
+    while (length > 0 && name[length - 1] == ' ') {
+        length--;
+    }
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        if (strlen(level_names[i]) == length && strncmp(level_names[i], name, length) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool has_suffix(const char* text, const char* suffix) {
+    size_t text_length = strlen(text);
+    size_t suffix_length = strlen(suffix);
+    return text_length >= suffix_length && strcmp(text + text_length - suffix_length, suffix) == 0;
+}
+
+/**
+ * @brief The fields of a log line the filter looks at.
+ */
+typedef struct LineFields {
+    uint64_t index;
+    int64_t time;
+    int level;                // -1 if not recognised
+    const char* label;
+    size_t label_length;
+} LineFields;
+
+/**
+ * @brief Skips an expected piece of text.
+ * @return The text after it, or NULL if it is not there.
+ */
+static const char* skip_text(const char* p, const char* expected) {
+    size_t length = strlen(expected);
+    return strncmp(p, expected, length) == 0 ? p + length : NULL;
+}
+
+/**
+ * @brief Parses a JSON log line, whose fields the logger always writes in the same order:
+ *        {"index":N,"timestamp":"YYYY-MM-DDTHH:MM:SS[.fraction]","level":"LEVEL","label":"label",...
+ */
+static bool parse_json_line(const char* line, LineFields* fields) {
+    const char* p = skip_text(line, "{\"index\":");
+    if (!p || *p < '0' || *p > '9') {
+        return false;
+    }
+    fields->index = 0;
+    while (*p >= '0' && *p <= '9') {
+        fields->index = fields->index * 10 + (uint64_t)(*p++ - '0');
+    }
+    p = skip_text(p, ",\"timestamp\":\"");
+    if (!p || !log_archive_parse_time(p, &fields->time)) {
+        return false;
+    }
+    p = strchr(p, '"');
+    p = p ? skip_text(p, "\",\"level\":\"") : NULL;
+    const char* level_end = p ? strchr(p, '"') : NULL;
+    if (!level_end) {
+        return false;
+    }
+    fields->level = level_from_name(p, (size_t)(level_end - p));
+    fields->label = skip_text(level_end, "\",\"label\":\"");
+    const char* label_end = fields->label ? strchr(fields->label, '"') : NULL;
+    if (!label_end) {
+        return false;
+    }
+    fields->label_length = (size_t)(label_end - fields->label);
+    return true;
+}
+
+/**
+ * @brief Parses "<index> YYYY-MM-DD HH:MM:SS[.fraction] LEVEL: [label] message", or a JSON log line.
+ * @return false for a line that does not start like that, e.g. part of a hex dump.
+ */
+static bool parse_line(const char* line, LineFields* fields) {
+    if (line[0] == '{') {
+        return parse_json_line(line, fields);
+    }
+    const char* p = line;
+    fields->index = 0;
+    while (*p >= '0' && *p <= '9') {
+        fields->index = fields->index * 10 + (uint64_t)(*p++ - '0');
+    }
+    if (p == line || *p++ != ' ' || !log_archive_parse_time(p, &fields->time)) {
+        return false;
+    }
+    p += 19;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    if (*p++ != ' ') {
+        return false;
+    }
+    const char* level_end = strchr(p, ':');
+    if (!level_end || level_end[1] != ' ' || level_end[2] != '[') {
+        return false;
+    }
+    fields->level = level_from_name(p, (size_t)(level_end - p));
+    fields->label = level_end + 3;
+    const char* label_end = strchr(fields->label, ']');
+    if (!label_end) {
+        return false;
+    }
+    fields->label_length = (size_t)(label_end - fields->label);
+    return true;
+}
+
+static bool label_matches(const char* wanted, const LineFields* fields) {
+    size_t length = strlen(wanted);
+    if (fields->label_length < length || strncmp_nocase(fields->label, wanted, length) != 0) {
+        return false;
+    }
+    return fields->label_length == length || fields->label[length] == '.';
+}
+
+/**
+ * @brief Writes the lines of a stream that pass the filter, stopping once they are past its range.
+ */
+static void scan_stream(FILE* in, const SearchFilter* filter, SearchJob* job) {
+    char line[SEARCH_LINE_SIZE];
+    bool show = false;   // Lines that are not log lines go with the log line before them
+    bool line_start = true;
+
+    while (fgets(line, sizeof(line), in)) {
+        LineFields fields;
+        if (line_start && parse_line(line, &fields)) {
+            if (fields.index > filter->last_index || fields.time - SEARCH_TIME_SLACK_S > filter->to) {
+                break;
+            }
+            show = fields.index >= filter->first_index &&
+                   fields.time >= filter->from && fields.time <= filter->to &&
+                   (fields.level < 0 || fields.level >= filter->min_level) &&
+                   (!filter->label || label_matches(filter->label, &fields));
+            if (show) {
+                job->match_count++;
+            }
+        }
+        if (show) {
+            fputs(line, job->matches);
+        }
+        line_start = strchr(line, '\n') != NULL;
+    }
+}
+
+static void search_file(const SearchFilter* filter, SearchJob* job) {
+    job->matches = tmpfile();
+    if (!job->matches) {
+        job->failed = true;
+        return;
+    }
+
+    if (has_suffix(job->path, LOG_ARCHIVE_EXTENSION)) {
+        // Only the blocks overlapping the time range are decompressed
+        FILE* blocks = tmpfile();
+        if (!blocks || !log_archive_read_range(job->path, filter->from, filter->to, blocks)) {
+            job->failed = true;
+        } else {
+            rewind(blocks);
+            scan_stream(blocks, filter, job);
+        }
+        if (blocks) {
+            fclose(blocks);
+        }
+        return;
+    }
+
+    FILE* in = fopen(job->path, "rb");
+    if (!in) {
+        job->failed = true;
+        return;
+    }
+    // Index points carry log times too, so allow them the same slack as lines
+    int64_t from = filter->from > INT64_MIN + SEARCH_TIME_SLACK_S ? filter->from - SEARCH_TIME_SLACK_S : INT64_MIN;
+    uint64_t offset = 0;
+    if (log_index_find_start(job->path, filter->first_index, from, &offset) && offset > 0) {
+        // If the seek fails the stream stays at 0 and the whole file is read
+        platform_fseek(in, (int64_t)offset, SEEK_SET);
+    }
+    scan_stream(in, filter, job);
+    fclose(in);
+}
+
+static void* search_thread(void* arg) {
+    SearchContext* context = (SearchContext*)arg;
+    for (;;) {
+        uint32_t job = platform_atomic_fetch_add_uint32(&context->next_job, 1);
+        if (job >= context->job_count) {
+            return NULL;
+        }
+        search_file(context->filter, &context->jobs[job]);
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [options] <log file or .erlz archive>...\n"
+        "  --from \"YYYY-MM-DD HH:MM:SS\"  Earliest log time shown\n"
+        "  --to \"YYYY-MM-DD HH:MM:SS\"    Latest log time shown\n"
+        "  --first N                     Lowest entry index shown\n"
+        "  --last N                      Highest entry index shown\n"
+        "  --level LEVEL                 Lowest level shown, e.g. WARN\n"
+        "  --label LABEL                 Thread label shown, with its dotted children\n"
+        "  --threads N                   Files scanned in parallel (default 4)\n",
+        program);
+}
+
+int main(int argc, char* argv[]) {
+    SearchFilter filter = { INT64_MIN, INT64_MAX, 0, UINT64_MAX, 0, NULL };
+    int thread_count = 4;
+
+    int arg = 1;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg += 2) {
+        const char* option = argv[arg];
+        const char* value = arg + 1 < argc ? argv[arg + 1] : NULL;
+        bool valid = value != NULL;
+        if (valid && strcmp(option, "--from") == 0) {
+            valid = log_archive_parse_time(value, &filter.from);
+        } else if (valid && strcmp(option, "--to") == 0) {
+            valid = log_archive_parse_time(value, &filter.to);
+        } else if (valid && strcmp(option, "--first") == 0) {
+            filter.first_index = strtoull(value, NULL, 10);
+        } else if (valid && strcmp(option, "--last") == 0) {
+            filter.last_index = strtoull(value, NULL, 10);
+        } else if (valid && strcmp(option, "--level") == 0) {
+            filter.min_level = level_from_name(value, strlen(value));
+            valid = filter.min_level >= 0;
+        } else if (valid && strcmp(option, "--label") == 0) {
+            filter.label = value;
+        } else if (valid && strcmp(option, "--threads") == 0) {
+            thread_count = atoi(value);
+            valid = thread_count > 0;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            fprintf(stderr, "Invalid option %s %s\n", option, value ? value : "");
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (arg >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    SearchContext context = { &filter, NULL, (uint32_t)(argc - arg), {0} };
+    context.jobs = calloc(context.job_count, sizeof(*context.jobs));
+    if (!context.jobs) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < context.job_count; i++) {
+        context.jobs[i].path = argv[arg + (int)i];
+    }
+
+    // This thread scans too, so one file or --threads 1 needs no others
+    if ((uint32_t)thread_count > context.job_count) {
+        thread_count = (int)context.job_count;
+    }
+    if (thread_count > SEARCH_MAX_THREADS) {
+        thread_count = SEARCH_MAX_THREADS;
+    }
+    PlatformThreadId threads[SEARCH_MAX_THREADS];
+    int started = 0;
+    for (int i = 1; i < thread_count; i++) {
+        if (platform_thread_create(&threads[started], NULL, search_thread, &context) == PLATFORM_ERROR_SUCCESS) {
+            started++;
+        }
+    }
+    search_thread(&context);
+    for (int i = 0; i < started; i++) {
+        platform_thread_join((PlatformThreadHandle)threads[i], NULL);
+    }
+
+    int result = 0;
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < context.job_count; i++) {
+        SearchJob* job = &context.jobs[i];
+        if (job->failed) {
+            fprintf(stderr, "Could not search %s\n", job->path);
+            result = 1;
+        }
+        if (job->matches) {
+            char buffer[SEARCH_LINE_SIZE];
+            size_t length;
+            rewind(job->matches);
+            while ((length = fread(buffer, 1, sizeof(buffer), job->matches)) > 0) {
+                fwrite(buffer, 1, length, stdout);
+            }
+            fclose(job->matches);
+        }
+        total += job->match_count;
+    }
+    fprintf(stderr, "%llu matching entries in %u files\n", (unsigned long long)total, context.job_count);
+
+    free(context.jobs);
+    return result;
+}
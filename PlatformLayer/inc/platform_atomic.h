@@ -224,6 +224,16 @@ uint32_t platform_atomic_fetch_add_uint32(PlatformAtomicUInt32* atomic, uint32_t
 int64_t  platform_atomic_fetch_add_int64(PlatformAtomicInt64* atomic, int64_t value);
 uint64_t platform_atomic_fetch_add_uint64(PlatformAtomicUInt64* atomic, uint64_t value);
 
+/**
+ * @brief Load and store operations with an explicit memory order
+ *
+ * The plain operations above are sequentially consistent. These let lock-free
+ * code ask for only what it needs, typically an acquire load pairing with a
+ * release store.
+ */
+uint32_t platform_atomic_load_explicit_uint32(const PlatformAtomicUInt32* atomic, PlatformMemoryOrder order);
+void platform_atomic_store_explicit_uint32(PlatformAtomicUInt32* atomic, uint32_t value, PlatformMemoryOrder order);
+
 /**
  * @brief Memory fence operation
  */
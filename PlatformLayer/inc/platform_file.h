@@ -78,4 +78,52 @@ PlatformErrorCode platform_file_get_size(
  */
 void platform_file_close(PlatformFileHandle handle);
 
+// Opaque handle to a file mapped into memory for writing
+typedef struct PlatformMappedFile* PlatformMappedFileHandle;
+
+/**
+ * @brief Opens or creates a file, preallocates it and maps it for writing
+ *
+ * Writes to the mapping reach the file through the page cache with no
+ * system call per write. The mapping is shared, so written data survives
+ * the process exiting abnormally.
+ *
+ * @param filepath Path to the file
+ * @param size Bytes to preallocate and map; a larger existing file is mapped whole
+ * @param truncate Discard any existing content first
+ * @param error_code Optional pointer to receive error code
+ * @return PlatformMappedFileHandle NULL if failed
+ */
+PlatformMappedFileHandle platform_mapped_file_open(
+    const char* filepath,
+    size_t size,
+    bool truncate,
+    PlatformErrorCode* error_code
+);
+
+/**
+ * @brief Gets the start of a mapped file's memory
+ *
+ * @param handle Mapped file handle
+ * @return Pointer to the mapping, NULL for an invalid handle
+ */
+void* platform_mapped_file_data(PlatformMappedFileHandle handle);
+
+/**
+ * @brief Gets the number of bytes mapped
+ *
+ * @param handle Mapped file handle
+ * @return Size of the mapping, 0 for an invalid handle
+ */
+size_t platform_mapped_file_size(PlatformMappedFileHandle handle);
+
+/**
+ * @brief Unmaps a file, cuts it to the length actually used and closes it
+ *
+ * @param handle Mapped file handle
+ * @param length Final length of the file, at most the mapped size
+ * @return PlatformErrorCode
+ */
+PlatformErrorCode platform_mapped_file_close(PlatformMappedFileHandle handle, size_t length);
+
 #endif // PLATFORM_FILE_H
@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <limits.h>
 
@@ -151,6 +152,32 @@ int platform_mkdir(const char* path);
  */
 PlatformErrorCode platform_fopen(FILE** file, const char* filename, const char* mode);
 
+/**
+ * @brief Moves a stream's position, with 64-bit offsets on every platform
+ * @param[in] file The stream
+ * @param[in] offset Offset from origin, may be past 2 GB
+ * @param[in] origin SEEK_SET, SEEK_CUR or SEEK_END
+ * @return PlatformErrorCode indicating success or failure
+ */
+PlatformErrorCode platform_fseek(FILE* file, int64_t offset, int origin);
+
+/**
+ * @brief Callback invoked for each entry of a directory listing
+ * @param[in] name Entry name, without the directory part
+ * @param[in] context Caller context passed to platform_list_directory
+ * @return true to continue listing, false to stop
+ */
+typedef bool (*PlatformDirEntryCallback)(const char* name, void* context);
+
+/**
+ * @brief List the entries of a directory, excluding "." and ".."
+ * @param[in] path Directory to list
+ * @param[in] callback Function called once per entry
+ * @param[in] context Passed through to the callback
+ * @return PlatformErrorCode indicating success or failure
+ */
+PlatformErrorCode platform_list_directory(const char* path, PlatformDirEntryCallback callback, void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,16 @@ typedef struct PlatformSocket {
 } PlatformSocket;
 
 
+/**
+ * @brief One of several buffers sent together by platform_socket_send_vectored
+ */
+typedef struct {
+    const void* data;   ///< Bytes to send
+    size_t length;      ///< Number of bytes
+} PlatformSocketBuffer;
+
+#define PLATFORM_SOCKET_MAX_BUFFERS 64  ///< Most buffers platform_socket_send_vectored passes in one call
+
 /**
  * @brief Opaque socket handle type
  */
@@ -159,6 +169,24 @@ PlatformErrorCode platform_socket_send(
     size_t length,
     size_t* bytes_sent);
 
+/**
+ * @brief Send several buffers in one call, as if they were one
+ *
+ * Like platform_socket_send, may send less than all of it; only the first
+ * PLATFORM_SOCKET_MAX_BUFFERS buffers are looked at.
+ *
+ * @param[in] handle Socket handle
+ * @param[in] buffers Buffers to send, in order
+ * @param[in] count Number of buffers
+ * @param[out] bytes_sent Pointer to store number of bytes sent
+ * @return PlatformErrorCode indicating success or failure
+ */
+PlatformErrorCode platform_socket_send_vectored(
+    PlatformSocketHandle handle,
+    const PlatformSocketBuffer* buffers,
+    size_t count,
+    size_t* bytes_sent);
+
 /**
  * @brief Receive data
  * @param[in] handle Socket handle
@@ -173,6 +201,17 @@ PlatformErrorCode platform_socket_receive(
     size_t length,
     size_t* bytes_received);
 
+/**
+ * @brief Get the number of bytes that can be received without blocking
+ * @param[in] handle Socket handle
+ * @param[out] bytes_available Pointer to store the byte count; for UDP this is the size of
+ *             the next datagram on Linux, but all queued bytes on Windows and macOS
+ * @return PlatformErrorCode indicating success or failure
+ */
+PlatformErrorCode platform_socket_bytes_available(
+    PlatformSocketHandle handle,
+    size_t* bytes_available);
+
 /**
  * @brief Check if socket is connected
  * @param[in] handle Socket handle
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "platform_threads.h"
+#include "platform_atomic.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,6 +81,36 @@ PlatformErrorCode platform_event_reset(PlatformEvent_T event);
  */
 PlatformErrorCode platform_event_wait(PlatformEvent_T event, uint32_t timeout_ms);
 
+/**
+ * @brief Block while an atomic value still holds an expected value
+ *
+ * Lightweight notification in the style of a futex: the caller parks only
+ * if *address == expected at the time of the call, so a wake that races with
+ * the check is never lost. Callers must re-check their condition on return,
+ * as wakes can be spurious.
+ *
+ * @param address Atomic value to wait on
+ * @param expected Value that keeps the caller parked
+ * @param timeout_ms Maximum time to wait in milliseconds (PLATFORM_WAIT_INFINITE for infinite)
+ * @return PlatformWaitResult PLATFORM_WAIT_SUCCESS if woken or the value differed,
+ *                            PLATFORM_WAIT_TIMEOUT on timeout
+ */
+PlatformWaitResult platform_wait_on_address(PlatformAtomicUInt32* address, uint32_t expected, uint32_t timeout_ms);
+
+/**
+ * @brief Wake one thread parked in platform_wait_on_address on this address
+ *
+ * @param address Atomic value the waiter is parked on, changed by the caller beforehand
+ */
+void platform_wake_by_address_single(PlatformAtomicUInt32* address);
+
+/**
+ * @brief Wake all threads parked in platform_wait_on_address on this address
+ *
+ * @param address Atomic value the waiters are parked on, changed by the caller beforehand
+ */
+void platform_wake_by_address_all(PlatformAtomicUInt32* address);
+
 /**
  * @brief Register a handler for a specific signal type
  * 
@@ -93,6 +93,13 @@ PlatformErrorCode platform_timestamp_elapsed(
     PlatformTimeGranularity granularity,
     uint64_t* elapsed);
 
+/**
+ * @brief Get how many timestamp counter ticks make up one second
+ * @param[out] ticks_per_second Frequency of PlatformHighResTimestamp_T counters
+ * @return PlatformErrorCode indicating success or failure
+ */
+PlatformErrorCode platform_get_timestamp_frequency(uint64_t* ticks_per_second);
+
 /**
  * @brief Thread-safe localtime function
  * @param[in] timer Time value to convert
@@ -304,6 +304,15 @@ uint64_t platform_atomic_fetch_add_uint64(PlatformAtomicUInt64* atomic, uint64_t
     return atomic_fetch_add((_Atomic uint64_t*)&atomic->value, value);
 }
 
+// Explicitly ordered 32-bit load and store; PlatformMemoryOrder follows memory_order
+uint32_t platform_atomic_load_explicit_uint32(const PlatformAtomicUInt32* atomic, PlatformMemoryOrder order) {
+    return atomic_load_explicit((_Atomic uint32_t*)&atomic->value, (memory_order)order);
+}
+
+void platform_atomic_store_explicit_uint32(PlatformAtomicUInt32* atomic, uint32_t value, PlatformMemoryOrder order) {
+    atomic_store_explicit((_Atomic uint32_t*)&atomic->value, value, (memory_order)order);
+}
+
 // Memory fence operation
 void platform_atomic_thread_fence(PlatformMemoryOrder order) {
     atomic_thread_fence(order);
@@ -4,6 +4,9 @@
 #include <sys/file.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define MAX_FILE_HANDLES 256
 
@@ -153,6 +156,103 @@ void platform_file_close(PlatformFileHandle handle) {
     }
 }
 
+struct PlatformMappedFile {
+    int fd;
+    void* data;
+    size_t size;
+};
+
+// Reserves the blocks up front where the file system allows, otherwise just sets the size
+static bool preallocate_file(int fd, size_t size) {
+#ifdef __linux__
+    if (posix_fallocate(fd, 0, (off_t)size) == 0) {
+        return true;
+    }
+#endif
+    return ftruncate(fd, (off_t)size) == 0;
+}
+
+PlatformMappedFileHandle platform_mapped_file_open(
+    const char* filepath,
+    size_t size,
+    bool truncate,
+    PlatformErrorCode* error_code
+) {
+    if (!filepath || size == 0) {
+        if (error_code) *error_code = PLATFORM_ERROR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    struct PlatformMappedFile* mapped = malloc(sizeof(*mapped));
+    if (!mapped) {
+        if (error_code) *error_code = PLATFORM_ERROR_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    int flags = O_RDWR | O_CREAT | (truncate ? O_TRUNC : 0);
+    mapped->fd = open(filepath, flags, 0644);
+    if (mapped->fd == -1) {
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_OPEN;
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(mapped->fd, &st) == -1) {
+        close(mapped->fd);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_ACCESS;
+        return NULL;
+    }
+    mapped->size = ((size_t)st.st_size > size) ? (size_t)st.st_size : size;
+
+    if (!preallocate_file(mapped->fd, mapped->size)) {
+        close(mapped->fd);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_WRITE;
+        return NULL;
+    }
+
+    mapped->data = mmap(NULL, mapped->size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->fd, 0);
+    if (mapped->data == MAP_FAILED) {
+        close(mapped->fd);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    if (error_code) *error_code = PLATFORM_ERROR_SUCCESS;
+    return mapped;
+}
+
+void* platform_mapped_file_data(PlatformMappedFileHandle handle) {
+    return handle ? handle->data : NULL;
+}
+
+size_t platform_mapped_file_size(PlatformMappedFileHandle handle) {
+    return handle ? handle->size : 0;
+}
+
+PlatformErrorCode platform_mapped_file_close(PlatformMappedFileHandle handle, size_t length) {
+    if (!handle) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    PlatformErrorCode result = PLATFORM_ERROR_SUCCESS;
+    if (munmap(handle->data, handle->size) == -1) {
+        result = PLATFORM_ERROR_SYSTEM;
+    }
+    // Give back the preallocated space that was never written
+    if (ftruncate(handle->fd, (off_t)(length < handle->size ? length : handle->size)) == -1) {
+        result = PLATFORM_ERROR_FILE_WRITE;
+    }
+    if (close(handle->fd) == -1) {
+        result = PLATFORM_ERROR_FILE_WRITE;
+    }
+    free(handle);
+    return result;
+}
+
 #ifdef _DEBUG
 // Debug helper to check for file handle leaks
 size_t platform_file_get_open_count(void) {
@@ -13,6 +13,7 @@
 #include <libgen.h>
 #include <stdbool.h>
 #include <sys/stat.h>
+#include <dirent.h>
 
 // Platform-specific constants
 const char PATH_SEPARATOR = '/';
@@ -265,3 +266,39 @@ PlatformErrorCode platform_fopen(FILE** file, const char* filename, const char*
     
     return PLATFORM_ERROR_SUCCESS;
 }
+
+PlatformErrorCode platform_fseek(FILE* file, int64_t offset, int origin) {
+    if (!file) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    // off_t is 64 bits on 64-bit systems, and with _FILE_OFFSET_BITS=64 on 32-bit ones
+    if ((int64_t)(off_t)offset != offset || fseeko(file, (off_t)offset, origin) != 0) {
+        return PLATFORM_ERROR_FILE_ACCESS;
+    }
+    return PLATFORM_ERROR_SUCCESS;
+}
+
+PlatformErrorCode platform_list_directory(const char* path, PlatformDirEntryCallback callback, void* context) {
+    if (!path || !callback) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    DIR* dir = opendir(path);
+    if (!dir) {
+        return (errno == ENOENT) ? PLATFORM_ERROR_FILE_NOT_FOUND : PLATFORM_ERROR_FILE_ACCESS;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        if (!callback(entry->d_name, context)) {
+            break;
+        }
+    }
+
+    closedir(dir);
+    return PLATFORM_ERROR_SUCCESS;
+}
@@ -10,10 +10,19 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
 
 #include "platform_time.h"
 #include "platform_error.h"
 
+// A peer that has gone away must show up as a send error, not a SIGPIPE that ends the process
+#ifdef MSG_NOSIGNAL
+#define SOCKET_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SOCKET_SEND_FLAGS 0
+#endif
+
 PlatformErrorCode platform_socket_init(void) {
     return PLATFORM_ERROR_SUCCESS; // No initialization needed for POSIX
 }
@@ -113,6 +122,10 @@ PlatformErrorCode platform_socket_create(
         free(sock);
         return PLATFORM_ERROR_SOCKET_CREATE;
     }
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    setsockopt(sock->fd, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
 
     // Set socket options if provided
     if (options) {
@@ -390,7 +403,45 @@ PlatformErrorCode platform_socket_send(
 
     *bytes_sent = 0;
     
-    ssize_t sent = send(handle->fd, buffer, length, 0);
+    ssize_t sent = send(handle->fd, buffer, length, SOCKET_SEND_FLAGS);
+    if (sent < 0) {
+        if (errno == EWOULDBLOCK && !handle->opts.blocking) {
+            return PLATFORM_ERROR_WOULD_BLOCK;
+        }
+        return PLATFORM_ERROR_SOCKET_SEND;
+    }
+
+    *bytes_sent = (size_t)sent;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
+PlatformErrorCode platform_socket_send_vectored(
+    PlatformSocketHandle handle,
+    const PlatformSocketBuffer* buffers,
+    size_t count,
+    size_t* bytes_sent)
+{
+    if (!handle || !buffers || !bytes_sent) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    *bytes_sent = 0;
+
+    struct iovec vectors[PLATFORM_SOCKET_MAX_BUFFERS];
+    if (count > PLATFORM_SOCKET_MAX_BUFFERS) {
+        count = PLATFORM_SOCKET_MAX_BUFFERS;
+    }
+    for (size_t i = 0; i < count; i++) {
+        vectors[i].iov_base = (void*)buffers[i].data;
+        vectors[i].iov_len = buffers[i].length;
+    }
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = vectors;
+    message.msg_iovlen = count;
+
+    ssize_t sent = sendmsg(handle->fd, &message, SOCKET_SEND_FLAGS);
     if (sent < 0) {
         if (errno == EWOULDBLOCK && !handle->opts.blocking) {
             return PLATFORM_ERROR_WOULD_BLOCK;
@@ -434,6 +485,24 @@ PlatformErrorCode platform_socket_receive(
     return PLATFORM_ERROR_SUCCESS;
 }
 
+PlatformErrorCode platform_socket_bytes_available(
+    PlatformSocketHandle handle,
+    size_t* bytes_available)
+{
+    if (!handle || !bytes_available) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    int available = 0;
+    if (ioctl(handle->fd, FIONREAD, &available) < 0) {
+        *bytes_available = 0;
+        return PLATFORM_ERROR_SOCKET_RECEIVE;
+    }
+
+    *bytes_available = available > 0 ? (size_t)available : 0;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
 PlatformErrorCode platform_socket_is_connected(
     PlatformSocketHandle handle,
     bool* is_connected)
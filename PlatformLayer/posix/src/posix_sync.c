@@ -16,10 +16,16 @@
 #include <signal.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 #include "platform_threads.h"
 #include "platform_time.h"    // For sleep_ms function
 #include "platform_error.h"
+#include "platform_atomic.h"
 
 
 struct platform_event {
@@ -377,6 +383,123 @@ PlatformErrorCode platform_event_wait(PlatformEvent_T event, uint32_t timeout_ms
     return PLATFORM_ERROR_SUCCESS;
 }
 
+#if defined(__linux__)
+/*
+ * Linux: the kernel futex does exactly what platform_wait_on_address promises.
+ */
+PlatformWaitResult platform_wait_on_address(PlatformAtomicUInt32* address, uint32_t expected, uint32_t timeout_ms) {
+    if (!address) {
+        return PLATFORM_WAIT_ERROR;
+    }
+
+    struct timespec ts;
+    struct timespec* timeout = NULL;
+    if (timeout_ms != PLATFORM_WAIT_INFINITE) {
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+        timeout = &ts;
+    }
+
+    if (syscall(SYS_futex, &address->value, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0) == 0) {
+        return PLATFORM_WAIT_SUCCESS;
+    }
+    switch (errno) {
+        case ETIMEDOUT: return PLATFORM_WAIT_TIMEOUT;
+        case EAGAIN:    // Value already differed
+        case EINTR:     return PLATFORM_WAIT_SUCCESS;
+        default:        return PLATFORM_WAIT_ERROR;
+    }
+}
+
+void platform_wake_by_address_single(PlatformAtomicUInt32* address) {
+    if (address) {
+        syscall(SYS_futex, &address->value, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+void platform_wake_by_address_all(PlatformAtomicUInt32* address) {
+    if (address) {
+        syscall(SYS_futex, &address->value, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+    }
+}
+
+#else
+/*
+ * Other POSIX systems have no portable futex, so addresses hash onto a small
+ * table of mutex/condition pairs. The value is re-checked under the bucket
+ * mutex and wakers take the same mutex, so no wake can slip between the
+ * check and the wait.
+ */
+#define ADDRESS_WAIT_BUCKETS 64
+
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} g_address_buckets[ADDRESS_WAIT_BUCKETS];
+
+static pthread_once_t g_address_buckets_once = PTHREAD_ONCE_INIT;
+
+static void init_address_buckets(void) {
+    for (int i = 0; i < ADDRESS_WAIT_BUCKETS; i++) {
+        pthread_mutex_init(&g_address_buckets[i].mutex, NULL);
+        pthread_cond_init(&g_address_buckets[i].cond, NULL);
+    }
+}
+
+static size_t address_bucket(const PlatformAtomicUInt32* address) {
+    pthread_once(&g_address_buckets_once, init_address_buckets);
+    return ((uintptr_t)address >> 4) % ADDRESS_WAIT_BUCKETS;
+}
+
+PlatformWaitResult platform_wait_on_address(PlatformAtomicUInt32* address, uint32_t expected, uint32_t timeout_ms) {
+    if (!address) {
+        return PLATFORM_WAIT_ERROR;
+    }
+
+    size_t bucket = address_bucket(address);
+    struct timespec ts;
+    if (timeout_ms != PLATFORM_WAIT_INFINITE) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += timeout_ms / 1000;
+        ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec += 1;
+            ts.tv_nsec -= 1000000000;
+        }
+    }
+
+    PlatformWaitResult result = PLATFORM_WAIT_SUCCESS;
+    pthread_mutex_lock(&g_address_buckets[bucket].mutex);
+    if (platform_atomic_load_uint32(address) == expected) {
+        int ret = (timeout_ms == PLATFORM_WAIT_INFINITE)
+            ? pthread_cond_wait(&g_address_buckets[bucket].cond, &g_address_buckets[bucket].mutex)
+            : pthread_cond_timedwait(&g_address_buckets[bucket].cond, &g_address_buckets[bucket].mutex, &ts);
+        if (ret == ETIMEDOUT) {
+            result = PLATFORM_WAIT_TIMEOUT;
+        } else if (ret != 0) {
+            result = PLATFORM_WAIT_ERROR;
+        }
+    }
+    pthread_mutex_unlock(&g_address_buckets[bucket].mutex);
+    return result;
+}
+
+void platform_wake_by_address_single(PlatformAtomicUInt32* address) {
+    // Other addresses may share the bucket, so every waiter re-checks its own value
+    platform_wake_by_address_all(address);
+}
+
+void platform_wake_by_address_all(PlatformAtomicUInt32* address) {
+    if (!address) {
+        return;
+    }
+    size_t bucket = address_bucket(address);
+    pthread_mutex_lock(&g_address_buckets[bucket].mutex);
+    pthread_cond_broadcast(&g_address_buckets[bucket].cond);
+    pthread_mutex_unlock(&g_address_buckets[bucket].mutex);
+}
+#endif // __linux__
+
 PlatformWaitResult platform_wait_single(PlatformThreadId thread_id, 
                                       uint32_t timeout_ms) {
     if (!thread_id) {
@@ -101,6 +101,16 @@ PlatformErrorCode platform_timestamp_elapsed(
     return PLATFORM_ERROR_SUCCESS;
 }
 
+PlatformErrorCode platform_get_timestamp_frequency(uint64_t* ticks_per_second) {
+    if (!ticks_per_second) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Counters are nanoseconds since the epoch
+    *ticks_per_second = 1000000000ULL;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
 PlatformErrorCode platform_localtime(const time_t* timer, struct tm* result) {
     if (!timer || !result) {
         return PLATFORM_ERROR_INVALID_ARGUMENT;
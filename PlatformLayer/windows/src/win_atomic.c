@@ -325,6 +325,29 @@ uint64_t platform_atomic_fetch_add_uint64(PlatformAtomicUInt64* atomic, uint64_t
     return (uint64_t)InterlockedExchangeAdd64((volatile LONGLONG*)&atomic->value, (LONGLONG)value);
 }
 
+// Explicitly ordered 32-bit load and store
+uint32_t platform_atomic_load_explicit_uint32(const PlatformAtomicUInt32* atomic, PlatformMemoryOrder order) {
+    if (order == PLATFORM_MEMORY_ORDER_SEQ_CST) {
+        return platform_atomic_load_uint32(atomic);
+    }
+    uint32_t value = *(volatile const uint32_t*)&atomic->value;
+    if (order != PLATFORM_MEMORY_ORDER_RELAXED) {
+        platform_atomic_thread_fence(PLATFORM_MEMORY_ORDER_ACQ_REL);
+    }
+    return value;
+}
+
+void platform_atomic_store_explicit_uint32(PlatformAtomicUInt32* atomic, uint32_t value, PlatformMemoryOrder order) {
+    if (order == PLATFORM_MEMORY_ORDER_SEQ_CST) {
+        platform_atomic_store_uint32(atomic, value);
+        return;
+    }
+    if (order != PLATFORM_MEMORY_ORDER_RELAXED) {
+        platform_atomic_thread_fence(PLATFORM_MEMORY_ORDER_ACQ_REL);
+    }
+    *(volatile uint32_t*)&atomic->value = value;
+}
+
 // Memory fence operation
 void platform_atomic_thread_fence(PlatformMemoryOrder order) {
     switch (order) {
@@ -1,6 +1,7 @@
 #include "platform_file.h"
 #include "platform_error.h"
 #include <windows.h>
+#include <stdlib.h>
 
 #define MAX_FILE_HANDLES 256
 
@@ -136,6 +137,113 @@ void platform_file_close(PlatformFileHandle handle) {
     }
 }
 
+struct PlatformMappedFile {
+    HANDLE file;
+    HANDLE mapping;
+    void* data;
+    size_t size;
+};
+
+static bool set_file_length(HANDLE file, size_t length) {
+    LARGE_INTEGER position;
+    position.QuadPart = (LONGLONG)length;
+    return SetFilePointerEx(file, position, NULL, FILE_BEGIN) && SetEndOfFile(file);
+}
+
+PlatformMappedFileHandle platform_mapped_file_open(
+    const char* filepath,
+    size_t size,
+    bool truncate,
+    PlatformErrorCode* error_code
+) {
+    if (!filepath || size == 0) {
+        if (error_code) *error_code = PLATFORM_ERROR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    struct PlatformMappedFile* mapped = malloc(sizeof(*mapped));
+    if (!mapped) {
+        if (error_code) *error_code = PLATFORM_ERROR_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    // Readers may open the file while it is written, and rotation renames it once closed
+    mapped->file = CreateFileA(
+        filepath,
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (mapped->file == INVALID_HANDLE_VALUE) {
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_OPEN;
+        return NULL;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(mapped->file, &file_size)) {
+        CloseHandle(mapped->file);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_ACCESS;
+        return NULL;
+    }
+    mapped->size = ((size_t)file_size.QuadPart > size) ? (size_t)file_size.QuadPart : size;
+
+    // Extending the file allocates its space now rather than on first write
+    if (!set_file_length(mapped->file, mapped->size)) {
+        CloseHandle(mapped->file);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_FILE_WRITE;
+        return NULL;
+    }
+
+    ULARGE_INTEGER map_size;
+    map_size.QuadPart = (ULONGLONG)mapped->size;
+    mapped->mapping = CreateFileMappingA(mapped->file, NULL, PAGE_READWRITE,
+                                         map_size.HighPart, map_size.LowPart, NULL);
+    mapped->data = mapped->mapping ? MapViewOfFile(mapped->mapping, FILE_MAP_WRITE, 0, 0, mapped->size) : NULL;
+    if (!mapped->data) {
+        if (mapped->mapping) CloseHandle(mapped->mapping);
+        CloseHandle(mapped->file);
+        free(mapped);
+        if (error_code) *error_code = PLATFORM_ERROR_OUT_OF_MEMORY;
+        return NULL;
+    }
+
+    if (error_code) *error_code = PLATFORM_ERROR_SUCCESS;
+    return mapped;
+}
+
+void* platform_mapped_file_data(PlatformMappedFileHandle handle) {
+    return handle ? handle->data : NULL;
+}
+
+size_t platform_mapped_file_size(PlatformMappedFileHandle handle) {
+    return handle ? handle->size : 0;
+}
+
+PlatformErrorCode platform_mapped_file_close(PlatformMappedFileHandle handle, size_t length) {
+    if (!handle) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    PlatformErrorCode result = PLATFORM_ERROR_SUCCESS;
+    if (!UnmapViewOfFile(handle->data)) {
+        result = PLATFORM_ERROR_SYSTEM;
+    }
+    CloseHandle(handle->mapping);
+    // The file can only be cut once no mapping of it remains
+    if (!set_file_length(handle->file, length < handle->size ? length : handle->size)) {
+        result = PLATFORM_ERROR_FILE_WRITE;
+    }
+    CloseHandle(handle->file);
+    free(handle);
+    return result;
+}
+
 #ifdef _DEBUG
 // Debug helper to check for file handle leaks
 size_t platform_file_get_open_count(void) {
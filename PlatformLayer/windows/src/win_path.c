@@ -266,3 +266,44 @@ PlatformErrorCode platform_fopen(FILE** file, const char* filename, const char*
     
     return PLATFORM_ERROR_SUCCESS;
 }
+
+PlatformErrorCode platform_fseek(FILE* file, int64_t offset, int origin) {
+    if (!file) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (_fseeki64(file, offset, origin) != 0) {
+        return PLATFORM_ERROR_FILE_ACCESS;
+    }
+    return PLATFORM_ERROR_SUCCESS;
+}
+
+PlatformErrorCode platform_list_directory(const char* path, PlatformDirEntryCallback callback, void* context) {
+    if (!path || !callback) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    char pattern[MAX_PATH_LEN];
+    if (snprintf(pattern, sizeof(pattern), "%s\\*", path) >= (int)sizeof(pattern)) {
+        return PLATFORM_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    WIN32_FIND_DATAA find_data;
+    HANDLE find = FindFirstFileA(pattern, &find_data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return (GetLastError() == ERROR_FILE_NOT_FOUND || GetLastError() == ERROR_PATH_NOT_FOUND)
+            ? PLATFORM_ERROR_FILE_NOT_FOUND : PLATFORM_ERROR_FILE_ACCESS;
+    }
+
+    do {
+        if (strcmp(find_data.cFileName, ".") == 0 || strcmp(find_data.cFileName, "..") == 0) {
+            continue;
+        }
+        if (!callback(find_data.cFileName, context)) {
+            break;
+        }
+    } while (FindNextFileA(find, &find_data));
+
+    FindClose(find);
+    return PLATFORM_ERROR_SUCCESS;
+}
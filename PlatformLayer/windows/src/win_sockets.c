@@ -380,6 +380,38 @@ PlatformErrorCode platform_socket_send(
     return PLATFORM_ERROR_SUCCESS;
 }
 
+PlatformErrorCode platform_socket_send_vectored(
+    PlatformSocketHandle handle,
+    const PlatformSocketBuffer* buffers,
+    size_t count,
+    size_t* bytes_sent)
+{
+    if (!handle || !buffers || !bytes_sent) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    WSABUF vectors[PLATFORM_SOCKET_MAX_BUFFERS];
+    if (count > PLATFORM_SOCKET_MAX_BUFFERS) {
+        count = PLATFORM_SOCKET_MAX_BUFFERS;
+    }
+    for (size_t i = 0; i < count; i++) {
+        vectors[i].buf = (CHAR*)buffers[i].data;
+        vectors[i].len = (ULONG)buffers[i].length;
+    }
+
+    DWORD sent = 0;
+    if (WSASend(handle->fd, vectors, (DWORD)count, &sent, 0, NULL, NULL) == SOCKET_ERROR) {
+        *bytes_sent = 0;
+        return (WSAGetLastError() == WSAEWOULDBLOCK && !handle->opts.blocking) ?
+               PLATFORM_ERROR_WOULD_BLOCK : PLATFORM_ERROR_SOCKET_SEND;
+    }
+
+    *bytes_sent = sent;
+    handle->stats.bytes_sent += sent;
+    handle->stats.packets_sent++;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
 PlatformErrorCode platform_socket_receive(
     PlatformSocketHandle handle,
     void* buffer,
@@ -408,6 +440,24 @@ PlatformErrorCode platform_socket_receive(
     return PLATFORM_ERROR_SUCCESS;
 }
 
+PlatformErrorCode platform_socket_bytes_available(
+    PlatformSocketHandle handle,
+    size_t* bytes_available)
+{
+    if (!handle || !bytes_available) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    u_long available = 0;
+    if (ioctlsocket(handle->fd, FIONREAD, &available) == SOCKET_ERROR) {
+        *bytes_available = 0;
+        return PLATFORM_ERROR_SOCKET_RECEIVE;
+    }
+
+    *bytes_available = (size_t)available;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
 PlatformErrorCode platform_socket_is_connected(
     PlatformSocketHandle handle,
     bool* is_connected)
@@ -92,6 +92,30 @@ PlatformErrorCode platform_event_wait(PlatformEvent_T event, uint32_t timeout_ms
     }
 }
 
+PlatformWaitResult platform_wait_on_address(PlatformAtomicUInt32* address, uint32_t expected, uint32_t timeout_ms) {
+    if (!address) {
+        return PLATFORM_WAIT_ERROR;
+    }
+
+    if (WaitOnAddress(&address->value, &expected, sizeof(expected),
+                      (timeout_ms == PLATFORM_WAIT_INFINITE) ? INFINITE : timeout_ms)) {
+        return PLATFORM_WAIT_SUCCESS;
+    }
+    return (GetLastError() == ERROR_TIMEOUT) ? PLATFORM_WAIT_TIMEOUT : PLATFORM_WAIT_ERROR;
+}
+
+void platform_wake_by_address_single(PlatformAtomicUInt32* address) {
+    if (address) {
+        WakeByAddressSingle(&address->value);
+    }
+}
+
+void platform_wake_by_address_all(PlatformAtomicUInt32* address) {
+    if (address) {
+        WakeByAddressAll(&address->value);
+    }
+}
+
 PlatformWaitResult platform_wait_single(PlatformThreadId thread_id, uint32_t timeout_ms) {
     if (!thread_id) {
         return PLATFORM_WAIT_ERROR;
@@ -122,6 +122,20 @@ PlatformErrorCode platform_timestamp_elapsed(
     return PLATFORM_ERROR_SUCCESS;
 }
 
+PlatformErrorCode platform_get_timestamp_frequency(uint64_t* ticks_per_second) {
+    if (!ticks_per_second) {
+        return PLATFORM_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Counters are raw QPC ticks
+    LARGE_INTEGER freq;
+    if (!QueryPerformanceFrequency(&freq) || freq.QuadPart <= 0) {
+        return PLATFORM_ERROR_UNKNOWN;
+    }
+    *ticks_per_second = (uint64_t)freq.QuadPart;
+    return PLATFORM_ERROR_SUCCESS;
+}
+
 PlatformErrorCode platform_localtime(const time_t* timer, struct tm* result) {
     if (!timer || !result) {
         return PLATFORM_ERROR_INVALID_ARGUMENT;